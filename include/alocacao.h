@@ -10,6 +10,32 @@
 #ifndef ALOCACAO_H
 #define ALOCACAO_H
 
+#include "bloco.h"
+
+/// Simulação sobre a qual as estratégias operam (ver memoria.h).
+typedef struct simulador simulador_t;
+
+/// Função de uma estratégia de alocação: devolve 1 se alocou, 0 se faltou espaço.
+typedef int (*funcao_alocacao_t)(simulador_t *sim, int pid, bloco_t tamanho);
+
+/// Estado do Next Fit de uma simulação.
+typedef struct {
+    bloco_t ponteiro; ///< Fim da última alocação feita pelo Next Fit
+    long pedidos;     ///< Pedidos atendidos pelo Next Fit
+    long examinados;  ///< Regiões examinadas por esses pedidos
+} estado_next_fit_t;
+
+/// Índice de cada estratégia em `nomes_estrategias` e nas métricas (ver metricas.h).
+enum {
+    ESTRATEGIA_FIRST,
+    ESTRATEGIA_BEST,
+    ESTRATEGIA_WORST,
+    ESTRATEGIA_NEXT,
+    ESTRATEGIA_SEG,
+    ESTRATEGIA_BUDDY,
+    NUM_ESTRATEGIAS
+};
+
 /**
  * @brief Aloca memória utilizando a estratégia First Fit.
  *
@@ -20,20 +46,20 @@
  * @param tamanho A quantidade de blocos (unidades) de memória a serem alocadas.
  * @return int Retorna 1 (sucesso) se a alocação for bem-sucedida, ou 0 (falha) se não houver espaço suficiente.
  */
-int first_fit(int pid, int tamanho);
+int first_fit(simulador_t *sim, int pid, bloco_t tamanho);
 
 /**
  * @brief Aloca memória utilizando a estratégia Best Fit.
  *
- * Percorre toda a memória em busca do menor bloco livre contíguo
- * que seja suficientemente grande para acomodar o processo. Minimiza
- * o espaço desperdiçado, mas pode ser mais lento que First Fit.
+ * Busca o menor bloco livre contíguo que seja suficientemente grande
+ * para acomodar o processo. Minimiza o espaço desperdiçado. A busca usa
+ * o índice de regiões livres ordenado por tamanho (ver indice_livre.h).
  *
  * @param pid O identificador do processo que está requisitando memória.
  * @param tamanho A quantidade de blocos (unidades) de memória a serem alocadas.
  * @return int Retorna 1 (sucesso) se a alocação for bem-sucedida, ou 0 (falha) se não houver espaço suficiente.
  */
-int best_fit(int pid, int tamanho);
+int best_fit(simulador_t *sim, int pid, bloco_t tamanho);
 
 
 /**
@@ -51,7 +77,107 @@ int best_fit(int pid, int tamanho);
  * @return int Retorna 1 se a alocação for bem-sucedida, ou 0 se não houver
  *             bloco suficientemente grande disponível.
  */
-int worst_fit(int pid, int tamanho);
+int worst_fit(simulador_t *sim, int pid, bloco_t tamanho);
+
+/**
+ * @brief Aloca memória utilizando a estratégia Next Fit.
+ *
+ * Como o First Fit, mas a busca recomeça de onde terminou a última alocação
+ * feita por esta estratégia (ponteiro "rotativo"), e volta ao início da
+ * memória se não houver região adequada depois dele.
+ *
+ * @param pid O identificador do processo que está requisitando memória.
+ * @param tamanho A quantidade de blocos (unidades) de memória a serem alocadas.
+ * @return int Retorna 1 (sucesso) se a alocação for bem-sucedida, ou 0 (falha) se não houver espaço suficiente.
+ */
+int next_fit(simulador_t *sim, int pid, bloco_t tamanho);
+
+/**
+ * @brief Média de regiões livres examinadas por pedido do Next Fit.
+ *
+ * Conta os nós do índice visitados pelas buscas (incluindo a volta ao início)
+ * desde o início da execução.
+ *
+ * @return double Média por pedido, ou 0 se nenhum pedido foi feito.
+ */
+double next_fit_media_examinados(const simulador_t *sim);
+
+/**
+ * @brief Aloca memória usando listas segregadas por classe de tamanho.
+ *
+ * Pedidos pequenos (até `CLASSES_PEQUENAS` blocos) são atendidos pela menor
+ * região pequena que os comporte, achada em O(1) pelo mapa de bits das
+ * listas segregadas (ver indice_livre.h). Pedidos grandes, ou pequenos sem
+ * região pequena disponível, recorrem ao Best Fit.
+ *
+ * @param pid O identificador do processo que será alocado.
+ * @param tamanho O número de blocos de memória necessários para o processo.
+ * @return int Retorna 1 se a alocação for bem-sucedida, ou 0 se não houver
+ *             espaço suficiente.
+ */
+int segregado_fit(simulador_t *sim, int pid, bloco_t tamanho);
+
+/**
+ * @brief Aloca memória usando o sistema buddy.
+ *
+ * O pedido é arredondado para a próxima potência de dois, 2^k, e o processo
+ * recebe um bloco de 2^k unidades alinhado a 2^k, tirado da lista livre da
+ * menor ordem disponível >= k e dividido ao meio até a ordem k. Na liberação,
+ * o bloco é fundido com seu buddy enquanto este estiver livre. A diferença
+ * entre o bloco e o pedido é contada como fragmentação interna
+ * (ver `fragmentacao_t`).
+ *
+ * @param pid O identificador do processo que será alocado.
+ * @param tamanho O número de blocos de memória necessários para o processo.
+ * @return int Retorna 1 se a alocação for bem-sucedida, ou 0 se não houver
+ *             bloco alinhado suficientemente grande disponível.
+ */
+int buddy_fit(simulador_t *sim, int pid, bloco_t tamanho);
+
+/// Pedido de um lote de alocações (ver `alocar_lote`).
+typedef struct {
+    int pid;          ///< Processo
+    bloco_t tamanho;  ///< Número de blocos pedidos
+    bloco_t inicio;   ///< Saída: início da extensão alocada, ou -1 se o pedido falhou
+} pedido_lote_t;
+
+/**
+ * @brief Aloca um lote de pedidos com uma estratégia.
+ *
+ * Com `first_fit`, o lote inteiro é colocado numa única passagem pelas
+ * regiões livres, em ordem de endereço: cada região recebe, em ordem, os
+ * pedidos pendentes que ainda cabem no que sobrou dela, e a passagem salta
+ * direto para a próxima região capaz de receber o menor pedido pendente. O
+ * resultado é o mesmo de chamar `first_fit` pedido a pedido, mas só são
+ * visitadas regiões que recebem algum pedido. As demais estratégias são
+ * chamadas pedido a pedido. Em todas, cada pedido válido conta nas métricas
+ * da estratégia, e o lote inteiro também conta em `lotes`.
+ *
+ * Com `ordenar`, os pedidos são atendidos do maior para o menor (empates na
+ * ordem do lote), o que costuma aproveitar melhor o espaço. Pedidos com PID
+ * inválido, já alocado, na fila de espera ou repetido no lote falham, assim
+ * como os que não couberem; pedidos que falham não vão para a fila de espera.
+ *
+ * @param pedidos Pedidos do lote; o campo `inicio` de cada um recebe o resultado.
+ * @param quantidade Número de pedidos.
+ * @param alocar Estratégia.
+ * @param ordenar Se diferente de zero, atende os maiores pedidos primeiro.
+ * @return int Número de pedidos atendidos.
+ */
+int alocar_lote(simulador_t *sim, pedido_lote_t *pedidos, int quantidade, funcao_alocacao_t alocar, int ordenar);
+
+/**
+ * @brief Procura uma estratégia pelo nome usado nos comandos.
+ *
+ * Nomes aceitos: `first`, `best`, `worst`, `next`, `seg` e `buddy`.
+ *
+ * @param nome Nome da estratégia.
+ * @return funcao_alocacao_t A função da estratégia, ou NULL se o nome for desconhecido.
+ */
+funcao_alocacao_t estrategia_por_nome(const char *nome);
+
+/// Nomes de todas as estratégias, na ordem da interface, terminados por NULL.
+extern const char *const nomes_estrategias[];
 
 
 #endif // ALOCACAO_H
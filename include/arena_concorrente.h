@@ -0,0 +1,96 @@
+/**
+ * @file arena_concorrente.h
+ * @brief Memória simulada que aceita alocações e liberações de várias threads.
+ *
+ * O espaço de endereços é dividido em fragmentos (shards) contíguos, cada um
+ * com seu próprio índice de regiões livres e sua própria trava. Cada thread
+ * tem um fragmento "de casa" e aloca nele; só quando ele não tem uma região
+ * grande o suficiente a thread rouba espaço livre de outro fragmento. Assim
+ * threads diferentes raramente disputam a mesma trava.
+ *
+ * Os processos ficam em tabelas de PIDs também fragmentadas (pelo hash do
+ * PID), com travas próprias, independentes das travas de endereço.
+ *
+ * Um pedido que não cabe em nenhum fragmento sozinho (por exemplo, maior que
+ * um fragmento) ainda pode ser atendido por um trecho livre que atravessa
+ * fronteiras: esse caso, raro, trava todos os fragmentos em ordem de
+ * endereço e procura o primeiro trecho contíguo grande o bastante.
+ */
+
+#ifndef ARENA_CONCORRENTE_H
+#define ARENA_CONCORRENTE_H
+
+#include <pthread.h>
+#include "bloco.h"
+#include "indice_livre.h"
+#include "tabela_pid.h"
+
+/// Trecho contíguo da memória com índice e trava próprios.
+typedef struct {
+    pthread_mutex_t trava;  ///< Protege `livres` e os contadores
+    indice_livre_t livres;  ///< Regiões livres do fragmento
+    bloco_t inicio;         ///< Primeiro bloco do fragmento
+    bloco_t fim;            ///< Primeiro bloco após o fragmento
+    long alocacoes;         ///< Alocações atendidas pelo fragmento
+    long roubos;            ///< Alocações atendidas para threads de outro fragmento
+} __attribute__((aligned(64))) fragmento_t;
+
+/// Parte da tabela de processos, escolhida pelo hash do PID.
+typedef struct {
+    pthread_mutex_t trava;  ///< Protege `processos`
+    tabela_pid_t processos; ///< Extensões dos PIDs desta parte
+} __attribute__((aligned(64))) tabela_fragmento_t;
+
+/// Memória simulada concorrente.
+typedef struct {
+    bloco_t tamanho;                 ///< Número total de blocos
+    int num_fragmentos;              ///< Número de fragmentos de endereço
+    fragmento_t *fragmentos;         ///< Fragmentos, em ordem de endereço
+    int num_tabelas;                 ///< Número de partes da tabela de processos
+    tabela_fragmento_t *tabelas;     ///< Partes da tabela de processos
+    long atravessadas;               ///< Alocações que atravessaram fronteiras (com todas as travas)
+} arena_concorrente_t;
+
+/**
+ * @brief Cria uma memória concorrente toda livre.
+ *
+ * @param arena Estrutura a inicializar.
+ * @param tamanho Número total de blocos.
+ * @param num_fragmentos Número de fragmentos (tipicamente o número de threads).
+ * @return int 0 em caso de sucesso, -1 se os parâmetros forem inválidos.
+ */
+int arena_criar(arena_concorrente_t *arena, bloco_t tamanho, int num_fragmentos);
+
+/**
+ * @brief Libera todas as estruturas da memória concorrente.
+ */
+void arena_destruir(arena_concorrente_t *arena);
+
+/**
+ * @brief Aloca `tamanho` blocos contíguos (First Fit dentro do fragmento).
+ *
+ * Tenta primeiro o fragmento da thread; se ele não tiver espaço, procura
+ * nos demais, começando pelos que não estão travados no momento. Por fim,
+ * procura um trecho livre que atravesse fronteiras entre fragmentos.
+ *
+ * @return bloco_t Primeiro bloco alocado, ou -1 se não houver trecho livre contíguo do tamanho pedido.
+ */
+bloco_t arena_alocar(arena_concorrente_t *arena, bloco_t tamanho);
+
+/**
+ * @brief Devolve um trecho obtido com `arena_alocar` (que pode atravessar fragmentos).
+ */
+void arena_liberar(arena_concorrente_t *arena, bloco_t inicio, bloco_t tamanho);
+
+/**
+ * @brief Aloca blocos para um processo, registrando a extensão na tabela de PIDs.
+ * @return int 1 se alocou, 0 se não houver espaço.
+ */
+int arena_alocar_pid(arena_concorrente_t *arena, int pid, bloco_t tamanho);
+
+/**
+ * @brief Libera todas as extensões de um processo.
+ */
+void arena_liberar_pid(arena_concorrente_t *arena, int pid);
+
+#endif // ARENA_CONCORRENTE_H
@@ -0,0 +1,15 @@
+/**
+ * @file bloco.h
+ * @brief Tipo usado para endereços e tamanhos na memória simulada.
+ *
+ * A memória pode ter bilhões de unidades, então endereços e tamanhos
+ * usam 64 bits.
+ */
+
+#ifndef BLOCO_H
+#define BLOCO_H
+
+/// Endereço ou quantidade de unidades (blocos) da memória simulada
+typedef long long bloco_t;
+
+#endif // BLOCO_H
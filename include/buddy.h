@@ -0,0 +1,102 @@
+/**
+ * @file buddy.h
+ * @brief Listas livres por ordem do sistema buddy (binary buddy system).
+ *
+ * O espaço livre da memória é visto como um conjunto de blocos alinhados de
+ * 2^k unidades (o bloco de ordem k que começa em `i` tem `i` múltiplo de 2^k).
+ * Cada ordem tem sua lista livre, e todos os blocos ficam também em uma treap
+ * por endereço, usada para localizar o "buddy" de um bloco (`inicio ^ 2^k`)
+ * na fusão e o bloco que contém um endereço na divisão.
+ *
+ * As listas são derivadas do índice de regiões livres e mantidas em dia pelos
+ * ganchos chamados por `memoria.c` (`buddy_ocupacao`, `buddy_liberacao`).
+ * Operações que reorganizam a memória inteira (compactação, carga de estado)
+ * apenas as invalidam; elas são reconstruídas na próxima alocação buddy.
+ */
+
+#ifndef BUDDY_H
+#define BUDDY_H
+
+#include "bloco.h"
+
+/// Simulação dona das listas (ver memoria.h).
+typedef struct simulador simulador_t;
+
+/// Maior ordem representável: blocos de até 2^62 unidades
+#define ORDEM_MAXIMA_BUDDY 62
+
+/// Bloco livre de 2^ordem unidades alinhado ao próprio tamanho.
+typedef struct bloco_buddy {
+    bloco_t inicio;            ///< Primeiro bloco (múltiplo de 2^ordem)
+    int ordem;                 ///< Log2 do tamanho do bloco
+    unsigned prioridade;       ///< Prioridade aleatória da treap por endereço
+    struct bloco_buddy *esq;   ///< Filho esquerdo na treap por endereço
+    struct bloco_buddy *dir;   ///< Filho direito na treap por endereço
+    struct bloco_buddy *ant;   ///< Anterior na lista livre da ordem
+    struct bloco_buddy *prox;  ///< Próximo na lista livre da ordem
+} bloco_buddy_t;
+
+/// Listas livres do buddy de uma simulação.
+typedef struct {
+    bloco_buddy_t *raiz;                           ///< Treap com todos os blocos livres, por início
+    bloco_buddy_t *listas[ORDEM_MAXIMA_BUDDY + 1]; ///< Lista livre de cada ordem
+    int validas;            ///< Se zero, as listas precisam ser reconstruídas antes do próximo uso
+    bloco_t desperdicio;    ///< Fragmentação interna acumulada das alocações buddy ativas
+} listas_buddy_t;
+
+/**
+ * @brief Retorna a menor ordem k tal que 2^k >= tamanho.
+ * @param tamanho Número de blocos pedidos (> 0).
+ */
+int buddy_ordem(bloco_t tamanho);
+
+/**
+ * @brief Retorna um bloco livre da menor ordem disponível que seja >= `ordem`.
+ *
+ * Reconstrói as listas a partir do índice de regiões livres se estiverem
+ * invalidadas. O bloco não é retirado das listas: ao ocupar parte dele com
+ * `ocupar_intervalo`, o gancho `buddy_ocupacao` faz as divisões.
+ *
+ * @return bloco_buddy_t* Bloco encontrado ou NULL se nenhuma ordem >= `ordem` tiver blocos.
+ */
+bloco_buddy_t *buddy_buscar(simulador_t *sim, int ordem);
+
+/**
+ * @brief Registra a fragmentação interna de uma alocação buddy.
+ *
+ * @param inicio Início da extensão recém-ocupada.
+ * @param desperdicio Blocos reservados além do tamanho pedido.
+ */
+void buddy_registrar_desperdicio(simulador_t *sim, bloco_t inicio, bloco_t desperdicio);
+
+/**
+ * @brief Total de blocos ocupados por alocações buddy além do pedido.
+ */
+bloco_t buddy_desperdicio(const simulador_t *sim);
+
+/**
+ * @brief Gancho: o intervalo livre [inicio, inicio + tamanho) foi ocupado.
+ *
+ * Os blocos buddy que o intersectam são divididos; as sobras voltam às listas.
+ */
+void buddy_ocupacao(simulador_t *sim, bloco_t inicio, bloco_t tamanho);
+
+/**
+ * @brief Gancho: a extensão [inicio, inicio + tamanho) está sendo liberada.
+ *
+ * Deve ser chamado antes de a extensão sair do mapa de ocupação. O intervalo
+ * é decomposto em blocos alinhados, fundidos com seus buddies livres.
+ */
+void buddy_liberacao(simulador_t *sim, bloco_t inicio, bloco_t tamanho);
+
+/**
+ * @brief Gancho: as extensões mudaram de lugar; as listas serão reconstruídas.
+ */
+void buddy_invalidar(simulador_t *sim);
+
+/**
+ * @brief Gancho: a memória foi esvaziada; descarta listas e contabilidade.
+ */
+void buddy_limpar(simulador_t *sim);
+
+#endif // BUDDY_H
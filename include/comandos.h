@@ -0,0 +1,151 @@
+/**
+ * @file comandos.h
+ * @brief Interpretação dos comandos textuais do simulador.
+ *
+ * Os mesmos comandos são usados pelo arquivo `comando.txt`, pelo modo lote
+ * e pelo modo servidor do processador. A configuração do interpretador
+ * (`definir_*`) fica na própria simulação (`simulador_t::sessao`), de modo que
+ * simulações distintas não interferem umas nas outras.
+ */
+
+#ifndef COMANDOS_H
+#define COMANDOS_H
+
+#include <stdio.h>
+#include "memoria.h"
+
+/// Tamanho máximo de uma linha de comando (um `lote` traz vários pedidos na mesma linha)
+#define TAM_LINHA 4096
+
+/// Resultado da execução de um comando.
+typedef enum {
+    COMANDO_FALHOU,     ///< O comando não pôde ser executado
+    COMANDO_OK,         ///< Comando executado com sucesso
+    COMANDO_RESPONDIDO, ///< Consulta executada; a resposta já foi escrita
+    COMANDO_ALTERADO,   ///< Comando que mudou a memória e já escreveu a sua resposta de dados
+    COMANDO_SAIR,       ///< Pedido de encerramento da sessão
+    COMANDO_DESLIGAR,   ///< Pedido de encerramento do servidor
+    COMANDO_IGNORADO,   ///< Linha vazia ou comentário
+    COMANDO_ENFILEIRADO ///< Alocação sem espaço estacionada na fila de espera
+} resultado_comando_t;
+
+/**
+ * @brief Define o arquivo e o formato usados para gravar o estado.
+ * @param arquivo Caminho do arquivo de estado (usado por `salvar` sem argumentos).
+ * @param binario Se diferente de zero, grava no formato binário (ver `estado_binario.h`).
+ */
+void definir_arquivo_estado(simulador_t *sim, const char *arquivo, int binario);
+
+/**
+ * @brief Grava o estado da memória no formato configurado.
+ * @param arquivo Arquivo de destino, ou NULL para o arquivo de estado configurado.
+ */
+void salvar_estado(simulador_t *sim, const char *arquivo);
+
+/**
+ * @brief Define a frequência das gravações intermediárias do estado.
+ *
+ * Sem diário, o estado é gravado a cada `intervalo` comandos executados com
+ * sucesso. Com diário, quando ele acumula `intervalo` operações desde o último
+ * checkpoint, o diário é compactado e o estado é gravado.
+ *
+ * @param intervalo Número de comandos/operações entre gravações (0 = nunca).
+ */
+void definir_checkpoint(simulador_t *sim, long intervalo);
+
+/**
+ * @brief Liga ou desliga o envio das alterações na resposta dos comandos.
+ *
+ * Ligado, o `ok` de `responder_comando` passa a ser
+ * `ok [<início> <tamanho> <pid>]...`: os trechos cujo dono mudou, na ordem
+ * em que mudaram (pid 0 = livre). Aplicados em ordem sobre o estado
+ * anterior, dão o estado atual, e um cliente (como a interface gráfica)
+ * pode redesenhar só esses trechos. Quando a lista não basta (mais de
+ * `LIMITE_ALTERACOES` trechos, `importar` ou `restaurar`), a resposta é `ok *` e o
+ * estado deve ser relido com `estado`. Os comandos que mudam a memória e têm
+ * resposta própria (`realocar`, `compactar <orçamento>` e `lote`) enviam a
+ * linha de alterações logo depois dela, numa segunda linha.
+ *
+ * @param ativo Se diferente de zero, as alterações são enviadas.
+ */
+void definir_alteracoes(simulador_t *sim, int ativo);
+
+/**
+ * @brief Interpreta os argumentos de `lote <algoritmo> [ordenar] <pid> <tamanho>...`.
+ *
+ * Usada por `executar_comando` e pela leitura de traces (`trace_carregar`).
+ *
+ * @param linha Texto do comando.
+ * @param algoritmo Recebe o nome da estratégia (ao menos 16 caracteres).
+ * @param ordenar Recebe 1 se o lote pede `ordenar`, 0 caso contrário.
+ * @param pedidos Recebe os pedidos, a liberar com `free`.
+ * @return int Número de pedidos, ou -1 se a linha for inválida (nada é alocado).
+ */
+int interpretar_lote(const char *linha, char *algoritmo, int *ordenar, pedido_lote_t **pedidos);
+
+/**
+ * @brief Executa um único comando.
+ *
+ * Os comandos suportados são:
+ * - `alocar <pid> <tamanho> <algoritmo> [prazo]` — aloca blocos para um processo usando a
+ *   estratégia definida. Sem espaço e com a fila de espera ligada (ver `espera.h`), o pedido
+ *   é estacionado e expira após `prazo` comandos (0 ou omitido: prazo padrão da fila).
+ * - `lote <algoritmo> [ordenar] <pid> <tamanho> [<pid> <tamanho>]...` — aloca vários
+ *   processos de uma vez (ver `alocar_lote`); com `ordenar`, os maiores primeiro. Responde
+ *   `lote <atendidos> [<pid> <início>]...`, na ordem dos pedidos (início -1 = falhou).
+ * - `liberar <pid>` — libera todos os blocos ocupados por um processo, ou retira o seu
+ *   pedido da fila de espera.
+ * - `realocar <pid> <tamanho> [algoritmo]` — muda o tamanho de um processo alocado,
+ *   no lugar sempre que possível (ver `realocar_memoria`); o algoritmo (padrão `first`)
+ *   só escolhe a região nova quando o processo precisa mudar de lugar. Responde
+ *   `realocar <movidos>`, o número de blocos copiados (0 = no lugar).
+ * - `compactar` — move todos os processos para o início da memória.
+ * - `compactar <orçamento>` — passo incremental que move no máximo `orçamento` blocos;
+ *   responde `compactar <movidos> <concluída> [<pid> <antigo> <novo> <tamanho>]...`.
+ * - `snapshot` — tira um instantâneo da memória (ver `instantaneo.h`) e responde `snapshot <id>`.
+ * - `restaurar <id>` — volta a memória ao instantâneo `id`, desfazendo só as alterações
+ *   feitas depois dele; o instantâneo continua disponível e os posteriores são descartados.
+ * - `descartar <id>` — descarta o instantâneo `id`.
+ * - `snapshots` — responde `snapshots <quantidade> [<id> <alterações desde ele>]...`.
+ * - `estado` — responde `estado <tamanho> [<início> <tamanho> <pid>]...`.
+ * - `fila` — responde `fila <pendentes> [<pid> <tamanho> <estratégia> <espera>]...`,
+ *   na ordem de atendimento.
+ * - `stats` — responde as estatísticas de fragmentação em uma linha JSON: `livres`,
+ *   `regioes`, `maior`, `menor`, `indice` (1 - maior / livres), `interna`,
+ *   `next_examinados`, `histograma` (posição k: regiões com 2^k a 2^(k+1) - 1 blocos)
+ *   `metricas` (contadores e latências por estratégia, ver `metricas_json`) e `espera`
+ *   (contadores e tempos da fila de espera, ver `espera_json`).
+ * - `salvar [arquivo]` — grava o estado da memória no formato configurado.
+ * - `exportar <arquivo>` — grava o estado no formato texto.
+ * - `importar <arquivo>` — substitui a memória pelo estado do arquivo (texto ou binário).
+ * - `sair` — encerra a sessão atual.
+ * - `desligar` — encerra o servidor.
+ *
+ * Linhas vazias e iniciadas por `#` são ignoradas.
+ *
+ * @param sim Simulação sobre a qual o comando atua.
+ * @param linha Texto do comando.
+ * @param saida Fluxo que recebe a resposta das consultas (`estado`, `stats`).
+ * @param erro Buffer que recebe a descrição da falha, se houver.
+ * @param tam_erro Tamanho do buffer `erro`.
+ * @return resultado_comando_t Resultado da execução.
+ */
+resultado_comando_t executar_comando(simulador_t *sim, const char *linha, FILE *saida, char *erro, size_t tam_erro);
+
+/**
+ * @brief Executa um comando e escreve a sua linha de resposta.
+ *
+ * A resposta é `ok` (com as alterações, ver `definir_alteracoes`),
+ * `espera` (pedido estacionado na fila), `erro <motivo>` ou a linha de
+ * dados de uma consulta. Com as alterações ligadas, os comandos que mudam a
+ * memória e têm resposta própria escrevem também a linha `ok ...`.
+ * Linhas ignoradas não geram resposta.
+ *
+ * @param sim Simulação sobre a qual o comando atua.
+ * @param linha Texto do comando.
+ * @param saida Fluxo que recebe a resposta.
+ * @return resultado_comando_t Resultado da execução.
+ */
+resultado_comando_t responder_comando(simulador_t *sim, const char *linha, FILE *saida);
+
+#endif // COMANDOS_H
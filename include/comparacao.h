@@ -0,0 +1,90 @@
+/**
+ * @file comparacao.h
+ * @brief Reprodução paralela de um trace para comparar estratégias de alocação.
+ *
+ * O trace (os mesmos comandos do modo lote) é lido uma única vez e então
+ * reproduzido, de forma independente, para cada combinação de estratégia e
+ * tamanho de memória. Cada combinação tem a sua própria simulação (ver
+ * `simulador_t`); uma thread por núcleo vai pegando as combinações de uma
+ * fila até esgotá-la.
+ *
+ * As linhas são interpretadas como em `executar_comando`. Nos comandos
+ * `alocar`, `realocar` e `lote`, a estratégia escrita no trace é ignorada:
+ * vale a estratégia da combinação. `liberar` e `compactar [orçamento]` são
+ * reproduzidos como estão; os demais comandos (consultas, `salvar`...) são
+ * ignorados. Linhas daqueles comandos que `executar_comando` recusaria não
+ * são reproduzidas, mas são contadas em `trace_t::invalidas`.
+ */
+
+#ifndef COMPARACAO_H
+#define COMPARACAO_H
+
+#include <stdio.h>
+#include "bloco.h"
+
+/// Operação de um trace já interpretado.
+typedef struct {
+    char tipo;       ///< 'A' (alocar), 'R' (realocar), 'L' (liberar), 'C' (compactar),
+                     ///< 'B' (lote, seguido dos seus pedidos) ou 'P' (pedido de um lote)
+    int pid;         ///< Processo (A, R, L e P) ou `ordenar` do lote (B)
+    bloco_t valor;   ///< Tamanho pedido (A, R e P), orçamento (C; 0 = compactação completa)
+                     ///< ou número de pedidos do lote (B)
+} operacao_trace_t;
+
+/// Sequência de operações lida de um arquivo de trace.
+typedef struct {
+    operacao_trace_t *operacoes;
+    long quantidade;
+    long capacidade;
+    long invalidas;  ///< Linhas de comandos reproduzíveis recusadas (não reproduzidas)
+} trace_t;
+
+/// Resultado da reprodução do trace para uma combinação.
+typedef struct {
+    const char *estrategia;  ///< Nome da estratégia
+    bloco_t tamanho;         ///< Tamanho da memória simulada
+    long alocacoes;          ///< Pedidos de alocação e realocação
+    long falhas;             ///< Pedidos de alocação e realocação não atendidos
+    double pico_indice;      ///< Maior índice de fragmentação observado
+    bloco_t livres;          ///< Blocos livres ao final
+    int regioes;             ///< Regiões livres ao final
+    bloco_t maior;           ///< Maior região livre ao final
+    bloco_t interna;         ///< Fragmentação interna (buddy) ao final
+    double segundos;         ///< Tempo de reprodução
+} resultado_comparacao_t;
+
+/**
+ * @brief Lê um trace de comandos.
+ *
+ * @param arquivo Caminho do trace (`-` para a entrada padrão).
+ * @param trace Recebe as operações; liberar com `trace_liberar`.
+ * @return int 0 em caso de sucesso, -1 se o arquivo não puder ser aberto.
+ */
+int trace_carregar(const char *arquivo, trace_t *trace);
+
+/**
+ * @brief Libera as operações de um trace.
+ */
+void trace_liberar(trace_t *trace);
+
+/**
+ * @brief Reproduz o trace para cada estratégia e cada tamanho de memória.
+ *
+ * @param trace Trace a reproduzir (somente leitura, compartilhado pelas threads).
+ * @param estrategias Nomes das estratégias (ver `estrategia_por_nome`).
+ * @param num_estrategias Número de estratégias.
+ * @param tamanhos Tamanhos de memória.
+ * @param num_tamanhos Número de tamanhos.
+ * @param resultados Vetor com `num_estrategias * num_tamanhos` posições, na
+ *        ordem estratégia-major.
+ * @return int 0 em caso de sucesso, -1 se alguma estratégia for desconhecida.
+ */
+int comparar_estrategias(const trace_t *trace, const char *const *estrategias, int num_estrategias,
+                         const bloco_t *tamanhos, int num_tamanhos, resultado_comparacao_t *resultados);
+
+/**
+ * @brief Escreve os resultados lado a lado, uma linha por combinação.
+ */
+void imprimir_comparacao(const resultado_comparacao_t *resultados, int quantidade, FILE *saida);
+
+#endif // COMPARACAO_H
@@ -0,0 +1,108 @@
+/**
+ * @file diario.h
+ * @brief Diário (journal) de operações, gravado apenas por acréscimo.
+ *
+ * Em vez de regravar todo o estado a cada comando, cada alteração da memória
+ * é acrescentada ao diário como uma linha curta, de tamanho proporcional à
+ * alteração. Periodicamente o diário é compactado em um checkpoint: o arquivo
+ * é reescrito contendo apenas as extensões ocupadas no momento.
+ *
+ * Formato (texto, uma operação por linha):
+ * ```
+ * diario <versão> <tamanho da memória> <extensões do checkpoint>
+ * A <pid> <início> <tamanho>    extensão ocupada
+ * L <pid>                       processo liberado
+ * C                             memória compactada
+ * M <origem> <destino> <tam>    trecho movido pela compactação incremental
+ * R <origem> <destino> <tam>    extensão redimensionada (tamanho 0 = liberada)
+ * ```
+ * As primeiras linhas `A` formam o checkpoint; as demais são operações
+ * posteriores a ele. A recuperação lê o checkpoint e reaplica as operações,
+ * então seu custo é limitado pelo intervalo entre checkpoints. Uma última
+ * linha incompleta (queda durante a escrita) é descartada.
+ */
+
+#ifndef DIARIO_H
+#define DIARIO_H
+
+#include <stdio.h>
+#include "bloco.h"
+
+/// Simulação registrada no diário (ver memoria.h).
+typedef struct simulador simulador_t;
+
+/// Versão atual do formato do diário
+#define VERSAO_DIARIO 1
+
+/// Diário de uma simulação.
+typedef struct {
+    FILE *arquivo;   ///< Diário aberto para acréscimo (NULL se inativo)
+    char *caminho;   ///< Caminho do diário aberto
+    long pendentes;  ///< Operações acrescentadas desde o último checkpoint
+} diario_t;
+
+/**
+ * @brief Recria a memória a partir de um diário existente.
+ *
+ * @param arquivo Caminho do diário.
+ * @return int 0 se a memória foi recuperada, -1 se o diário não existir ou
+ *         tiver cabeçalho inválido (a memória não é alterada).
+ */
+int diario_recuperar(simulador_t *sim, const char *arquivo);
+
+/**
+ * @brief Passa a registrar as operações no diário.
+ *
+ * Se `recuperado` for zero, o diário é recriado com um checkpoint da memória
+ * atual; caso contrário, as novas operações são acrescentadas ao final.
+ *
+ * @param arquivo Caminho do diário.
+ * @param recuperado Se a memória atual veio de `diario_recuperar(arquivo)`.
+ * @return int 0 em caso de sucesso, -1 se o arquivo não puder ser aberto.
+ */
+int diario_abrir(simulador_t *sim, const char *arquivo, int recuperado);
+
+/**
+ * @brief Reescreve o diário com um checkpoint da memória atual.
+ *
+ * O novo conteúdo é gravado em um arquivo temporário e renomeado sobre o
+ * diário, de modo que uma queda nunca deixa o diário sem checkpoint.
+ */
+void diario_checkpoint(simulador_t *sim);
+
+/**
+ * @brief Encerra o registro de operações, fechando o arquivo.
+ */
+void diario_fechar(simulador_t *sim);
+
+/**
+ * @brief Indica se há um diário aberto.
+ * @return int 1 se as operações estão sendo registradas, 0 caso contrário.
+ */
+int diario_ativo(const simulador_t *sim);
+
+/**
+ * @brief Número de operações registradas desde o último checkpoint.
+ */
+long diario_pendentes(const simulador_t *sim);
+
+/// Registra que `pid` passou a ocupar [inicio, inicio + tamanho).
+void diario_ocupacao(simulador_t *sim, int pid, bloco_t inicio, bloco_t tamanho);
+
+/// Registra que todas as extensões de `pid` foram liberadas.
+void diario_liberacao(simulador_t *sim, int pid);
+
+/// Registra uma compactação completa da memória.
+void diario_compactacao(simulador_t *sim);
+
+/**
+ * @brief Registra um passo de compactação incremental (ver `mover_extensao`).
+ */
+void diario_movimento(simulador_t *sim, bloco_t origem, bloco_t destino, bloco_t tamanho);
+
+/**
+ * @brief Registra uma extensão redimensionada (ver `redimensionar_extensao`).
+ */
+void diario_redimensionamento(simulador_t *sim, bloco_t origem, bloco_t destino, bloco_t tamanho);
+
+#endif // DIARIO_H
@@ -0,0 +1,163 @@
+/**
+ * @file espera.h
+ * @brief Fila de espera de alocações que falharam por falta de espaço.
+ *
+ * Com a fila ligada, um pedido de `alocar` que não encontra espaço não é
+ * perdido: ele fica estacionado e é refeito, com a mesma estratégia, quando
+ * `liberar_memoria` ou uma compactação abrem uma região grande o bastante.
+ * A ordem de atendimento segue a política:
+ * - FIFO: por ordem de chegada;
+ * - menor primeiro: pelo tamanho pedido (empate por chegada).
+ *
+ * O atendimento para no primeiro pedido da ordem que ainda não cabe, para
+ * que pedidos grandes não sejam ultrapassados indefinidamente.
+ *
+ * O tempo da fila é contado em comandos (`espera_avancar`), o que torna os
+ * prazos reprodutíveis num mesmo trace: um pedido com prazo `n` é descartado
+ * se não for atendido nos `n` comandos seguintes. A espera de cada pedido
+ * atendido é medida em comandos e em nanossegundos (histograma com as faixas
+ * de `metricas.h`).
+ *
+ * A fila não é gravada no estado nem no diário: pedidos pendentes se perdem
+ * ao encerrar o processador.
+ */
+
+#ifndef ESPERA_H
+#define ESPERA_H
+
+#include <stdio.h>
+#include "bloco.h"
+#include "alocacao.h"
+#include "metricas.h"
+
+/// Política da fila de espera.
+typedef enum {
+    ESPERA_DESLIGADA,   ///< Alocações sem espaço falham imediatamente
+    ESPERA_FIFO,        ///< Atende por ordem de chegada
+    ESPERA_MENOR        ///< Atende primeiro o menor pedido
+} politica_espera_t;
+
+/// Pedido estacionado.
+typedef struct {
+    int pid;
+    bloco_t tamanho;
+    funcao_alocacao_t alocar;     ///< Estratégia pedida
+    char metodo[16];              ///< Nome da estratégia (para `espera_listar`)
+    unsigned long long chegada;   ///< Comando em que o pedido entrou na fila
+    unsigned long long prazo;     ///< Comando a partir do qual o pedido expira (0 = sem prazo)
+    unsigned long long ordem;     ///< Número de chegada (único); 0 = posição livre
+    long long chegada_ns;         ///< Relógio monotônico na chegada
+    int prox;                     ///< Próxima posição do mesmo balde do índice por PID (-1 = fim)
+} pedido_espera_t;
+
+/// Referência a um pedido num heap; vale enquanto `ordem` for a do pedido.
+typedef struct {
+    int posicao;
+    unsigned long long ordem;
+} ref_espera_t;
+
+/// Heap binário de referências a pedidos.
+typedef struct {
+    ref_espera_t *itens;
+    int quantidade;
+    int capacidade;
+} heap_espera_t;
+
+/// Fila de espera de uma simulação.
+typedef struct {
+    politica_espera_t politica;
+    unsigned long long prazo_padrao; ///< Prazo dos pedidos sem prazo próprio (0 = sem prazo)
+
+    pedido_espera_t *pedidos;        ///< Posições de pedidos (livres têm `ordem` 0)
+    int capacidade;
+    int *livres;                     ///< Pilha de posições livres
+    int num_livres;
+    int *baldes;                     ///< Índice por PID: primeira posição de cada balde (-1 = vazio), um balde por posição
+    heap_espera_t fila;              ///< Pedidos pela ordem de atendimento
+    heap_espera_t prazos;            ///< Pedidos com prazo, pelo prazo
+
+    int pendentes;                   ///< Pedidos na fila
+    unsigned long long relogio;      ///< Comandos contados por `espera_avancar`
+    unsigned long long sequencia;    ///< Último número de chegada
+
+    long enfileirados;               ///< Pedidos estacionados
+    long atendidos;                  ///< Pedidos alocados depois de esperar
+    long expirados;                  ///< Pedidos descartados pelo prazo
+    long cancelados;                 ///< Pedidos retirados por `liberar`
+    unsigned long long espera_total; ///< Soma das esperas (em comandos) dos atendidos
+    unsigned long long espera_maxima;///< Maior espera (em comandos) de um atendido
+    long latencia[FAIXAS_LATENCIA];  ///< Histograma da espera dos atendidos (faixa k: [2^k, 2^(k+1)) ns)
+} fila_espera_t;
+
+/**
+ * @brief Converte o nome de uma política (`fifo`, `menor`).
+ * @return int A política, ou -1 se o nome for desconhecido.
+ */
+int espera_politica_por_nome(const char *nome);
+
+/**
+ * @brief Liga, desliga ou troca a política da fila.
+ *
+ * Pedidos já estacionados são mantidos e reordenados pela nova política;
+ * ao desligar, eles são cancelados.
+ *
+ * @param politica Nova política.
+ * @param prazo_padrao Prazo, em comandos, dos pedidos sem prazo próprio (0 = sem prazo).
+ */
+void espera_configurar(simulador_t *sim, politica_espera_t politica, unsigned long long prazo_padrao);
+
+/**
+ * @brief Estaciona um pedido que falhou por falta de espaço.
+ *
+ * @param prazo Prazo do pedido em comandos (0 = `prazo_padrao`).
+ * @return int 1 se o pedido foi estacionado, 0 se a fila estiver desligada.
+ */
+int espera_enfileirar(simulador_t *sim, int pid, bloco_t tamanho, funcao_alocacao_t alocar,
+                      const char *metodo, unsigned long long prazo);
+
+/**
+ * @brief Indica se há um pedido do processo na fila.
+ */
+int espera_contem(const simulador_t *sim, int pid);
+
+/**
+ * @brief Retira da fila o pedido do processo, se houver.
+ * @return int 1 se um pedido foi retirado, 0 caso contrário.
+ */
+int espera_cancelar(simulador_t *sim, int pid);
+
+/**
+ * @brief Refaz os pedidos que passaram a caber, na ordem da política.
+ *
+ * Chamada por `liberar_memoria` e pelas compactações; custa O(1) com a fila
+ * vazia ou quando o primeiro pedido ainda não cabe na maior região livre.
+ */
+void espera_atender(simulador_t *sim);
+
+/**
+ * @brief Conta um comando e descarta os pedidos cujo prazo venceu.
+ */
+void espera_avancar(simulador_t *sim);
+
+/**
+ * @brief Libera as estruturas da fila (pedidos pendentes são descartados).
+ */
+void espera_destruir(fila_espera_t *fila);
+
+/**
+ * @brief Escreve os pedidos pendentes, na ordem de atendimento.
+ *
+ * Formato: `fila <pendentes> [<pid> <tamanho> <estratégia> <espera em comandos>]...`.
+ */
+void espera_listar(const simulador_t *sim, FILE *saida);
+
+/**
+ * @brief Escreve os contadores da fila como um objeto JSON (sem quebra de linha).
+ *
+ * Campos: `politica`, `pendentes`, `enfileirados`, `atendidos`, `expirados`,
+ * `cancelados`, `espera_media` e `espera_maxima` (em comandos) e
+ * `latencia_ns` (histograma, cortado na última faixa não vazia).
+ */
+void espera_json(const fila_espera_t *fila, FILE *saida);
+
+#endif // ESPERA_H
@@ -0,0 +1,76 @@
+/**
+ * @file estado_binario.h
+ * @brief Formato binário, mapeável em memória, do estado do simulador.
+ *
+ * O arquivo tem um cabeçalho de tamanho fixo seguido das extensões ocupadas
+ * em ordem de endereço, em registros de tamanho fixo. Na carga o arquivo é
+ * mapeado com `mmap` e os registros são lidos diretamente do mapeamento, sem
+ * nenhuma conversão de texto; na gravação o arquivo é preenchido pelo
+ * mapeamento e descarregado com `msync`.
+ *
+ * Os inteiros são gravados na ordem de bytes da máquina.
+ */
+
+#ifndef ESTADO_BINARIO_H
+#define ESTADO_BINARIO_H
+
+#include <stdint.h>
+
+/// Simulação lida ou gravada (ver memoria.h).
+typedef struct simulador simulador_t;
+
+/// Assinatura no início de todo arquivo binário de estado
+#define MAGICA_ESTADO "GMEMBIN"
+
+/// Versão atual do formato
+#define VERSAO_ESTADO 1
+
+/// Cabeçalho do arquivo binário (64 bytes).
+typedef struct {
+    char magica[8];          ///< `MAGICA_ESTADO`, terminada em '\0'
+    uint32_t versao;         ///< `VERSAO_ESTADO`
+    uint32_t tam_registro;   ///< sizeof(registro_estado_t)
+    uint64_t tamanho;        ///< Número de unidades da memória
+    uint64_t geracao;        ///< Incrementada a cada gravação
+    uint64_t num_extensoes;  ///< Número de registros após o cabeçalho
+    uint64_t soma;           ///< Soma de verificação (FNV-1a) do cabeçalho e dos registros
+    uint64_t reservado[2];   ///< Zeros, para extensões futuras do formato
+} cabecalho_estado_t;
+
+/// Registro de uma extensão ocupada (24 bytes).
+typedef struct {
+    int64_t inicio;   ///< Primeiro bloco
+    int64_t tamanho;  ///< Número de blocos
+    int32_t pid;      ///< Processo dono
+    int32_t reservado;
+} registro_estado_t;
+
+/**
+ * @brief Verifica se um arquivo começa com a assinatura do formato binário.
+ * @return int 1 se for um estado binário, 0 caso contrário (ou se não existir).
+ */
+int arquivo_binario(const char *arquivo);
+
+/**
+ * @brief Carrega a memória a partir de um arquivo binário, via `mmap`.
+ *
+ * O cabeçalho, o tamanho do arquivo, a soma de verificação e os registros
+ * (dentro da memória, em ordem e sem sobreposição) são validados antes de a
+ * memória ser alterada: um arquivo inválido deixa a memória como estava.
+ *
+ * @return int 0 em caso de sucesso, -1 se o arquivo for inválido.
+ */
+int carregar_memoria_binaria(simulador_t *sim, const char *arquivo);
+
+/**
+ * @brief Grava a memória em um arquivo binário.
+ *
+ * O conteúdo é escrito em um arquivo temporário mapeado com `mmap`,
+ * descarregado com `msync` e então renomeado sobre `arquivo`, de modo que
+ * uma queda no meio da gravação não corrompe o estado anterior.
+ *
+ * @return int 0 em caso de sucesso, -1 em caso de erro de E/S.
+ */
+int salvar_memoria_binaria(simulador_t *sim, const char *arquivo);
+
+#endif // ESTADO_BINARIO_H
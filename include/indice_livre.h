@@ -0,0 +1,173 @@
+/**
+ * @file indice_livre.h
+ * @brief Índice das regiões livres (buracos) da memória simulada.
+ *
+ * Cada região livre maximal é representada por um nó que participa de duas
+ * árvores (treaps) ao mesmo tempo:
+ * - uma ordenada por endereço de início, aumentada com o maior tamanho da
+ *   subárvore, usada pelo First Fit e pelo Worst Fit;
+ * - outra ordenada por (tamanho, início), usada pelo Best Fit.
+ *
+ * As regiões pequenas (até `CLASSES_PEQUENAS` blocos) ficam também em listas
+ * segregadas por tamanho exato, com um mapa de bits das listas não vazias,
+ * para que pedidos pequenos encontrem uma região em O(1).
+ *
+ * O índice também mantém, a cada inserção e remoção, o total de blocos
+ * livres, o tamanho da menor região e um histograma dos tamanhos, para que
+ * as estatísticas de fragmentação sejam consultadas em O(1).
+ *
+ * Assim as estratégias de alocação custam O(log R), onde R é o número de
+ * regiões livres, em vez de percorrer a memória bloco a bloco.
+ */
+
+#ifndef INDICE_LIVRE_H
+#define INDICE_LIVRE_H
+
+#include "bloco.h"
+
+/// Regiões com até este número de blocos ficam nas listas segregadas (uma por tamanho)
+#define CLASSES_PEQUENAS 64
+
+/// Número de faixas do histograma de tamanhos (faixa k: tamanhos em [2^k, 2^(k+1)))
+#define FAIXAS_HISTOGRAMA 63
+
+/// Nó do índice: uma região livre contígua e maximal.
+typedef struct no_livre {
+    bloco_t inicio;           ///< Primeiro bloco da região
+    bloco_t tamanho;          ///< Quantidade de blocos livres
+    unsigned prioridade;      ///< Prioridade aleatória (compartilhada pelas duas árvores)
+    bloco_t maior;            ///< Maior tamanho na subárvore por endereço
+    struct no_livre *esq;     ///< Filho esquerdo na árvore por endereço
+    struct no_livre *dir;     ///< Filho direito na árvore por endereço
+    struct no_livre *esq_tam; ///< Filho esquerdo na árvore por tamanho
+    struct no_livre *dir_tam; ///< Filho direito na árvore por tamanho
+    struct no_livre *ant_classe;  ///< Anterior na lista segregada (regiões pequenas)
+    struct no_livre *prox_classe; ///< Próximo na lista segregada (regiões pequenas)
+} no_livre_t;
+
+/// Conjunto das regiões livres da memória.
+typedef struct {
+    no_livre_t *por_endereco; ///< Raiz da árvore ordenada por início
+    no_livre_t *por_tamanho;  ///< Raiz da árvore ordenada por (tamanho, início)
+    int quantidade;           ///< Número de regiões livres
+    no_livre_t *classes[CLASSES_PEQUENAS]; ///< Listas segregadas: `classes[t - 1]` tem as regiões de `t` blocos
+    unsigned long long classes_ocupadas;   ///< Bit `t - 1` ligado se `classes[t - 1]` não estiver vazia
+    bloco_t total;                         ///< Soma dos tamanhos de todas as regiões
+    bloco_t menor;                         ///< Tamanho da menor região (0 se não houver)
+    int histograma[FAIXAS_HISTOGRAMA];     ///< Número de regiões em cada faixa de tamanho
+} indice_livre_t;
+
+/// Trabalho feito pelas buscas do índice (contado por thread, ver metricas.h).
+typedef struct {
+    long regioes; ///< Nós (regiões livres) visitados pelas buscas
+    long blocos;  ///< Soma dos tamanhos das regiões visitadas
+} visitas_indice_t;
+
+/// Contadores de visitas das buscas da thread atual; só crescem.
+extern _Thread_local visitas_indice_t visitas_indice;
+
+/**
+ * @brief Esvazia o índice, liberando todos os nós.
+ * @param indice Índice a ser esvaziado.
+ */
+void indice_limpar(indice_livre_t *indice);
+
+/**
+ * @brief Retorna a região livre de menor endereço que começa em `endereco` ou depois.
+ *
+ * Permite percorrer as regiões em ordem de endereço:
+ * `for (r = indice_proximo(i, 0); r; r = indice_proximo(i, r->inicio + 1))`.
+ *
+ * @return no_livre_t* Região encontrada ou NULL se não houver nenhuma.
+ */
+no_livre_t *indice_proximo(const indice_livre_t *indice, bloco_t endereco);
+
+/**
+ * @brief Retorna a região livre de menor endereço com pelo menos `tamanho` blocos.
+ * @return no_livre_t* Região encontrada ou NULL se nenhuma for grande o suficiente.
+ */
+no_livre_t *indice_primeiro(const indice_livre_t *indice, bloco_t tamanho);
+
+/**
+ * @brief Retorna a região de menor endereço com início >= `endereco` e pelo menos `tamanho` blocos.
+ *
+ * Usada pelo Next Fit. A descida é guiada pelo maior tamanho de cada
+ * subárvore, descartando subárvores que não comportam o pedido.
+ *
+ * @param examinados Se não for NULL, recebe a soma do número de nós visitados.
+ * @return no_livre_t* Região encontrada ou NULL se nenhuma após `endereco` servir.
+ */
+no_livre_t *indice_primeiro_apos(const indice_livre_t *indice, bloco_t endereco, bloco_t tamanho,
+                                 long *examinados);
+
+/**
+ * @brief Retorna a menor região livre com pelo menos `tamanho` blocos.
+ *
+ * Em caso de empate no tamanho, a de menor endereço é escolhida.
+ *
+ * @return no_livre_t* Região encontrada ou NULL se nenhuma for grande o suficiente.
+ */
+no_livre_t *indice_melhor(const indice_livre_t *indice, bloco_t tamanho);
+
+/**
+ * @brief Retorna a maior região livre, desde que tenha pelo menos `tamanho` blocos.
+ *
+ * Em caso de empate no tamanho, a de menor endereço é escolhida.
+ *
+ * @return no_livre_t* Região encontrada ou NULL se nenhuma for grande o suficiente.
+ */
+no_livre_t *indice_maior(const indice_livre_t *indice, bloco_t tamanho);
+
+/**
+ * @brief Retorna uma região pequena de menor tamanho >= `tamanho`, em O(1).
+ *
+ * Consulta apenas as listas segregadas, por meio do mapa de bits. Entre as
+ * regiões do tamanho encontrado, retorna a mais recentemente inserida.
+ *
+ * @return no_livre_t* Região encontrada, ou NULL se nenhuma região com até
+ *         `CLASSES_PEQUENAS` blocos comportar o pedido.
+ */
+no_livre_t *indice_segregado(const indice_livre_t *indice, bloco_t tamanho);
+
+/**
+ * @brief Marca como ocupados os `tamanho` primeiros blocos de uma região livre.
+ *
+ * A região é removida do índice e, se sobrar espaço, o restante é reinserido.
+ *
+ * @param indice Índice das regiões livres.
+ * @param regiao Região retornada por uma das buscas.
+ * @param tamanho Número de blocos a ocupar (1 <= tamanho <= regiao->tamanho).
+ */
+void indice_ocupar(indice_livre_t *indice, no_livre_t *regiao, bloco_t tamanho);
+
+/**
+ * @brief Retorna a região livre que contém o bloco `endereco`.
+ * @return no_livre_t* Região encontrada ou NULL se o bloco estiver ocupado.
+ */
+no_livre_t *indice_contendo(const indice_livre_t *indice, bloco_t endereco);
+
+/**
+ * @brief Marca como ocupado um intervalo arbitrário dentro de uma região livre.
+ *
+ * A região que contém o intervalo é dividida em até duas sobras livres.
+ *
+ * @param indice Índice das regiões livres.
+ * @param inicio Primeiro bloco a ocupar.
+ * @param tamanho Número de blocos a ocupar.
+ * @return int 1 se o intervalo estava inteiramente livre, 0 caso contrário
+ *         (nesse caso o índice não é alterado).
+ */
+int indice_reservar(indice_livre_t *indice, bloco_t inicio, bloco_t tamanho);
+
+/**
+ * @brief Devolve ao índice um intervalo de blocos que acabou de ser liberado.
+ *
+ * O intervalo é fundido com as regiões livres vizinhas, se existirem.
+ *
+ * @param indice Índice das regiões livres.
+ * @param inicio Primeiro bloco liberado.
+ * @param tamanho Número de blocos liberados.
+ */
+void indice_liberar(indice_livre_t *indice, bloco_t inicio, bloco_t tamanho);
+
+#endif // INDICE_LIVRE_H
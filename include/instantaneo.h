@@ -0,0 +1,101 @@
+/**
+ * @file instantaneo.h
+ * @brief Instantâneos da memória para análises "e se" e desfazer.
+ *
+ * Um instantâneo não copia a memória: ele é uma marca num registro de
+ * desfazer. Enquanto houver algum instantâneo, cada extensão que entra ou
+ * sai do mapa de ocupação é anotada (uma alteração no lugar vira uma saída
+ * seguida de uma entrada), e restaurar um instantâneo desfaz, do fim para
+ * a marca, as anotações feitas depois dele. Tirar um instantâneo custa O(1)
+ * e restaurá-lo custa O(alterações desde ele), não O(tamanho do estado).
+ *
+ * Um instantâneo continua válido depois de restaurado, para que a mesma
+ * análise possa ser repetida com outras estratégias; os instantâneos
+ * tirados depois dele são descartados. O ponteiro do Next Fit faz parte do
+ * instantâneo; as métricas e a fila de espera não.
+ */
+
+#ifndef INSTANTANEO_H
+#define INSTANTANEO_H
+
+#include <stdio.h>
+#include "bloco.h"
+#include "alocacao.h"
+
+/// Tipo de uma anotação do registro de desfazer.
+typedef enum {
+    DESFAZER_ENTRADA,  ///< Extensão acrescentada em `inicio`
+    DESFAZER_SAIDA,    ///< Extensão retirada (com todos os campos)
+    DESFAZER_TAMANHO   ///< Memória esvaziada com o tamanho `tamanho`
+} tipo_desfazer_t;
+
+/// Anotação do registro de desfazer.
+typedef struct {
+    tipo_desfazer_t tipo;
+    int pid;
+    bloco_t inicio;
+    bloco_t tamanho;
+    bloco_t desperdicio;
+} anotacao_desfazer_t;
+
+/// Marca de um instantâneo no registro.
+typedef struct {
+    unsigned long long id;
+    long posicao;              ///< Anotações feitas antes do instantâneo
+    estado_next_fit_t next;    ///< Estado do Next Fit no instantâneo
+} marca_instantaneo_t;
+
+/// Instantâneos de uma simulação e o registro que eles compartilham.
+typedef struct {
+    anotacao_desfazer_t *anotacoes;
+    long quantidade;
+    long capacidade;
+    marca_instantaneo_t *marcas;   ///< Do mais antigo para o mais recente
+    int num_marcas;
+    int cap_marcas;
+    unsigned long long ultimo_id;
+} instantaneos_t;
+
+/**
+ * @brief Anota uma alteração do mapa de ocupação (chamada por `memoria.c`).
+ *
+ * Não faz nada se não houver instantâneos.
+ */
+void instantaneo_anotar(simulador_t *sim, tipo_desfazer_t tipo, bloco_t inicio, bloco_t tamanho,
+                        int pid, bloco_t desperdicio);
+
+/**
+ * @brief Tira um instantâneo do estado atual.
+ * @return unsigned long long Identificador do instantâneo (> 0).
+ */
+unsigned long long instantaneo_criar(simulador_t *sim);
+
+/**
+ * @brief Volta a memória ao estado do instantâneo `id`.
+ *
+ * Os instantâneos posteriores a ele são descartados. Com diário aberto, o
+ * diário é reescrito com um checkpoint do estado restaurado.
+ *
+ * @return long Número de anotações desfeitas, ou -1 se o instantâneo não existir.
+ */
+long instantaneo_restaurar(simulador_t *sim, unsigned long long id);
+
+/**
+ * @brief Descarta o instantâneo `id`, liberando o registro que só ele usava.
+ * @return int 0 em caso de sucesso, -1 se o instantâneo não existir.
+ */
+int instantaneo_descartar(simulador_t *sim, unsigned long long id);
+
+/**
+ * @brief Escreve os instantâneos existentes.
+ *
+ * Formato: `snapshots <quantidade> [<id> <alterações desde ele>]...`.
+ */
+void instantaneo_listar(const simulador_t *sim, FILE *saida);
+
+/**
+ * @brief Libera os instantâneos e o registro.
+ */
+void instantaneo_destruir(instantaneos_t *instantaneos);
+
+#endif // INSTANTANEO_H
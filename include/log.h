@@ -1,6 +1,87 @@
+/**
+ * @file log.h
+ * @brief Registro (log) assíncrono das falhas do simulador.
+ *
+ * Os registros são copiados para um anel em memória e gravados por uma
+ * thread de fundo, que mantém o arquivo aberto e só escreve quando o anel
+ * chega à metade, a cada `INTERVALO_LOG_MS` ou quando `log_descarregar` é
+ * chamado (por exemplo, ao fim de um lote). Assim uma rajada de falhas de
+ * alocação custa uma cópia em memória por falha, e não uma abertura de
+ * arquivo. Se o anel encher, quem registra espera a gravação liberar espaço:
+ * nenhum registro é perdido.
+ *
+ * Cada registro vira uma linha:
+ * ```
+ * [AAAA-MM-DD hh:mm:ss] <NÍVEL>: Processo <pid> | <método> | Motivo: <motivo>
+ * ```
+ * A data é formatada uma vez por segundo, não por registro.
+ */
+
 #ifndef LOG_H
 #define LOG_H
 
+/// Número de registros do anel
+#define CAPACIDADE_LOG 4096
+
+/// Intervalo máximo entre gravações, em milissegundos
+#define INTERVALO_LOG_MS 200
+
+/// Nível de um registro; registros abaixo do nível configurado são descartados.
+typedef enum {
+    NIVEL_LOG_DEPURACAO,
+    NIVEL_LOG_INFO,
+    NIVEL_LOG_AVISO,
+    NIVEL_LOG_ERRO
+} nivel_log_t;
+
+/**
+ * @brief Configura o log. Registros pendentes são gravados antes da troca.
+ *
+ * Sem configuração, o log grava em `log.txt`, a partir do nível `INFO`, com
+ * eco no terminal.
+ *
+ * @param caminho Arquivo de log (aberto para acréscimo), ou NULL para desligar o log.
+ * @param nivel Nível mínimo dos registros gravados.
+ * @param eco Se diferente de zero, cada registro também é escrito na saída padrão.
+ */
+void log_configurar(const char *caminho, nivel_log_t nivel, int eco);
+
+/**
+ * @brief Converte um nome de nível (`depuracao`, `info`, `aviso`, `erro`).
+ * @return int O nível, ou -1 se o nome for desconhecido.
+ */
+int log_nivel_por_nome(const char *nome);
+
+/**
+ * @brief Registra um evento de um processo.
+ *
+ * @param nivel Nível do registro.
+ * @param pid ID do processo.
+ * @param metodo Operação ou algoritmo envolvido (ex: "First Fit").
+ * @param motivo Texto explicando o evento.
+ */
+void log_registrar(nivel_log_t nivel, int pid, const char *metodo, const char *motivo);
+
+/**
+ * @brief Registra uma falha de alocação (nível `ERRO`).
+ *
+ * @param pid ID do processo que falhou.
+ * @param metodo Nome do algoritmo de alocação (ex: "First Fit").
+ * @param motivo Texto explicando a falha (ex: "memória insuficiente").
+ */
 void log_erro(int pid, const char *metodo, const char *motivo);
 
+/**
+ * @brief Espera até que todos os registros feitos até agora estejam gravados.
+ */
+void log_descarregar();
+
+/**
+ * @brief Grava os registros pendentes, encerra a thread de fundo e fecha o arquivo.
+ *
+ * Chamada automaticamente ao sair do programa; o log volta a funcionar no
+ * próximo registro.
+ */
+void log_encerrar();
+
 #endif
@@ -0,0 +1,67 @@
+/**
+ * @file mapa_ocupacao.h
+ * @brief Mapa das extensões ocupadas da memória, ordenado por endereço.
+ *
+ * Junto com o índice de regiões livres, descreve toda a memória simulada
+ * por meio de extensões (início, tamanho, PID). O consumo de memória do
+ * simulador passa a depender do número de alocações, e não do número de
+ * unidades simuladas.
+ */
+
+#ifndef MAPA_OCUPACAO_H
+#define MAPA_OCUPACAO_H
+
+#include "bloco.h"
+
+/// Extensão ocupada por um processo (nó de uma treap ordenada por início).
+typedef struct no_ocupado {
+    bloco_t inicio;             ///< Primeiro bloco da extensão
+    bloco_t tamanho;            ///< Número de blocos da extensão
+    int pid;                    ///< Processo dono da extensão
+    bloco_t desperdicio;        ///< Blocos reservados além do pedido (fragmentação interna)
+    unsigned prioridade;        ///< Prioridade aleatória da treap
+    struct no_ocupado *esq;     ///< Filho esquerdo
+    struct no_ocupado *dir;     ///< Filho direito
+} no_ocupado_t;
+
+/// Conjunto das extensões ocupadas.
+typedef struct {
+    no_ocupado_t *raiz; ///< Raiz da treap
+    int quantidade;     ///< Número de extensões
+} mapa_ocupacao_t;
+
+/**
+ * @brief Remove todas as extensões do mapa, liberando os nós.
+ * @param mapa Mapa a ser esvaziado.
+ */
+void mapa_limpar(mapa_ocupacao_t *mapa);
+
+/**
+ * @brief Registra uma extensão ocupada.
+ * @param mapa Mapa de ocupação.
+ * @param inicio Primeiro bloco da extensão.
+ * @param tamanho Número de blocos.
+ * @param pid Processo dono da extensão.
+ */
+void mapa_inserir(mapa_ocupacao_t *mapa, bloco_t inicio, bloco_t tamanho, int pid);
+
+/**
+ * @brief Remove a extensão que começa em `inicio`.
+ * @param mapa Mapa de ocupação.
+ * @param inicio Primeiro bloco da extensão a remover.
+ */
+void mapa_remover(mapa_ocupacao_t *mapa, bloco_t inicio);
+
+/**
+ * @brief Retorna a extensão de menor endereço que começa em `endereco` ou depois.
+ * @return no_ocupado_t* Extensão encontrada ou NULL.
+ */
+no_ocupado_t *mapa_proximo(const mapa_ocupacao_t *mapa, bloco_t endereco);
+
+/**
+ * @brief Retorna a extensão que contém o bloco `endereco`.
+ * @return no_ocupado_t* Extensão encontrada ou NULL se o bloco estiver livre.
+ */
+no_ocupado_t *mapa_contendo(const mapa_ocupacao_t *mapa, bloco_t endereco);
+
+#endif // MAPA_OCUPACAO_H
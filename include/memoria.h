@@ -10,63 +10,293 @@
 #ifndef MEMORIA_H
 #define MEMORIA_H
 
-/// Tamanho total da memória simulada (em unidades)
+#include "indice_livre.h"
+#include "mapa_ocupacao.h"
+#include "tabela_pid.h"
+#include "alocacao.h"
+#include "buddy.h"
+#include "diario.h"
+#include "metricas.h"
+#include "espera.h"
+#include "instantaneo.h"
+
+/// Tamanho padrão da memória simulada (em unidades)
 #define TAM_MEMORIA 100
 
 /**
- * @brief Vetor que representa a memória principal do sistema.
+ * @brief Maior memória (em unidades) salva e impressa bloco a bloco.
+ *
+ * Acima desse tamanho, o estado é salvo e exibido como lista de extensões.
+ */
+#define LIMITE_FORMATO_PLANO 1000000
+
+/**
+ * @brief Estado da memória principal simulada.
+ *
+ * A memória não é guardada bloco a bloco: ela é descrita por extensões.
+ * - `livres`: regiões livres maximais, consultadas pelas estratégias de alocação;
+ * - `ocupadas`: extensões ocupadas em ordem de endereço (início, tamanho, PID);
+ * - `processos`: extensões de cada PID, para liberar e consultar processos.
+ *
+ * O consumo de memória depende do número de alocações, não de `tamanho`.
+ */
+typedef struct {
+    bloco_t tamanho;          ///< Número de unidades da memória simulada
+    indice_livre_t livres;    ///< Regiões livres
+    mapa_ocupacao_t ocupadas; ///< Extensões ocupadas, por endereço
+    tabela_pid_t processos;   ///< Extensões de cada processo
+} memoria_t;
+
+/// Número máximo de alterações guardadas por comando
+#define LIMITE_ALTERACOES 64
+
+/// Trecho da memória que passou a pertencer a `pid` (0 = livre).
+typedef struct {
+    bloco_t inicio;
+    bloco_t tamanho;
+    int pid;
+} alteracao_t;
+
+/**
+ * @brief Trechos alterados desde `alteracoes_zerar`, na ordem em que ocorreram.
+ *
+ * Aplicar os itens em ordem sobre o estado anterior dá o estado atual. Se
+ * `incompleta` for diferente de zero (mais de `LIMITE_ALTERACOES` trechos,
+ * ou memória recriada por carga ou inicialização), a lista não basta e o
+ * estado deve ser lido de novo.
+ */
+typedef struct {
+    alteracao_t itens[LIMITE_ALTERACOES];
+    int quantidade;
+    int incompleta;
+} alteracoes_t;
+
+/**
+ * @brief Uma simulação completa: a memória e todo o estado que depende dela.
  *
- * Cada posição do vetor representa um bloco de memória:
- * - 0: bloco livre
- * - >0: bloco ocupado por um processo identificado pelo seu PID.
+ * Reúne a memória, o estado auxiliar das estratégias (ponteiro do Next Fit,
+ * listas do buddy), o diário, as métricas, a fila de espera, os instantâneos
+ * e a geração do estado binário.
+ * Todas as funções do simulador recebem a simulação como primeiro parâmetro
+ * (`sim`) e não usam nenhum outro estado, então um mesmo processo pode
+ * manter quantas simulações independentes quiser, inclusive em threads
+ * diferentes (cada simulação deve ser usada por uma thread por vez).
+ */
+/// Configuração do interpretador de comandos de uma simulação (ver `comandos.h`).
+typedef struct {
+    const char *arquivo_estado; ///< Arquivo gravado por `salvar` sem argumentos (NULL = `estado.txt`)
+    int binario;                ///< Se diferente de zero, o estado é gravado no formato binário
+    long intervalo_checkpoint;  ///< Comandos (ou operações do diário) entre gravações intermediárias; 0 = nunca
+    long desde_checkpoint;      ///< Comandos executados desde a última gravação (sem diário)
+    int alteracoes;             ///< Se diferente de zero, cada `ok` traz os trechos alterados pelo comando
+} sessao_comandos_t;
+
+struct simulador {
+    memoria_t memoria;        ///< Memória simulada
+    estado_next_fit_t next;   ///< Ponteiro rotativo e contadores do Next Fit
+    listas_buddy_t buddy;     ///< Listas livres do sistema buddy
+    diario_t diario;          ///< Diário de operações (inativo por padrão)
+    metricas_t metricas;      ///< Contadores e latências das operações
+    alteracoes_t alteracoes;  ///< Trechos alterados pelo comando atual
+    fila_espera_t espera;     ///< Alocações à espera de espaço (desligada por padrão)
+    instantaneos_t instantaneos; ///< Instantâneos e registro de desfazer (vazio por padrão)
+    bloco_t fim_montagem;     ///< Fim da última extensão aceita na montagem em andamento
+    unsigned long long geracao; ///< Geração do último estado binário lido ou gravado
+    sessao_comandos_t sessao; ///< Configuração dos comandos (padrão: texto, sem checkpoints)
+};
+
+/**
+ * @brief Cria uma simulação com a memória toda livre.
+ *
+ * @param sim Estrutura a inicializar.
+ * @param tamanho Número de unidades da memória (>= 0).
+ * @return int 0 em caso de sucesso, -1 se o tamanho for inválido.
+ */
+int simulador_criar(simulador_t *sim, bloco_t tamanho);
+
+/**
+ * @brief Libera todas as estruturas da simulação e fecha o seu diário.
+ */
+void simulador_destruir(simulador_t *sim);
+
+/**
+ * @brief Esvazia a lista de alterações (ver `alteracoes_t`).
  */
-extern int memoria[TAM_MEMORIA];
+void alteracoes_zerar(simulador_t *sim);
+
+/**
+ * @brief Redefine o tamanho da memória simulada e a deixa toda livre.
+ * @param tamanho Novo número de unidades (deve ser positivo).
+ */
+void definir_tamanho_memoria(simulador_t *sim, bloco_t tamanho);
 
 /**
  * @brief Inicializa a memória, marcando todos os blocos como livres.
  */
-void inicializar_memoria();
+void inicializar_memoria(simulador_t *sim);
+
+/**
+ * @brief Ocupa o início de uma região livre com um processo.
+ *
+ * Atualiza o índice de regiões livres, o mapa de ocupação e a tabela de processos.
+ *
+ * @param regiao Região livre obtida do índice `sim->memoria.livres`.
+ * @param tamanho Número de blocos a ocupar a partir do início da região.
+ * @param pid Identificador do processo dono dos blocos.
+ */
+void ocupar_regiao(simulador_t *sim, no_livre_t *regiao, bloco_t tamanho, int pid);
+
+/**
+ * @brief Ocupa um intervalo específico da memória com um processo.
+ *
+ * Usada quando a posição já é conhecida (por exemplo, ao reaplicar o diário).
+ *
+ * @param inicio Primeiro bloco do intervalo.
+ * @param tamanho Número de blocos.
+ * @param pid Identificador do processo dono dos blocos.
+ * @return int 1 se o intervalo estava inteiramente livre e foi ocupado, 0 caso contrário.
+ */
+int ocupar_intervalo(simulador_t *sim, bloco_t inicio, bloco_t tamanho, int pid);
 
 /**
  * @brief Libera todos os blocos de memória ocupados por um processo.
  * @param pid Identificador do processo cuja memória será liberada.
  */
-void liberar_memoria(int pid);
+void liberar_memoria(simulador_t *sim, int pid);
 
 /**
  * @brief Imprime o estado atual da memória no terminal.
  *
- * Útil para fins de depuração e visualização textual da memória.
+ * Útil para fins de depuração e visualização textual da memória. Memórias
+ * maiores que `LIMITE_FORMATO_PLANO` são exibidas como lista de extensões.
  */
-void imprimir_memoria();
+void imprimir_memoria(simulador_t *sim);
 
 /**
  * @brief Salva o estado atual da memória em um arquivo texto.
  *
- * O formato é uma sequência de inteiros separados por espaço, representando cada bloco.
+ * Até `LIMITE_FORMATO_PLANO` unidades, o formato é uma sequência de inteiros
+ * separados por espaço, representando cada bloco. Acima disso, é usado o
+ * formato de extensões (ver `salvar_memoria_extensoes`).
  *
  * @param arquivo Nome do arquivo onde o estado será salvo.
  */
-void salvar_memoria(const char *arquivo);
+void salvar_memoria(simulador_t *sim, const char *arquivo);
+
+/**
+ * @brief Salva o estado da memória como lista de extensões ocupadas.
+ *
+ * Formato:
+ * ```
+ * extensoes <tamanho da memória>
+ * <início> <tamanho> <pid>
+ * ...
+ * ```
+ * O tamanho do arquivo depende do número de alocações, não do tamanho da memória.
+ *
+ * @param arquivo Nome do arquivo onde o estado será salvo.
+ */
+void salvar_memoria_extensoes(simulador_t *sim, const char *arquivo);
 
 /**
  * @brief Compacta a memória movendo todos os blocos ocupados para o início.
  *
- * Esta função reorganiza a memória simulada de forma que todos os blocos usados
- * por processos sejam deslocados para o início do vetor de memória, enquanto os 
- * blocos livres (representados por 0) são deslocados para o final.
+ * Esta função reorganiza a memória simulada de forma que todas as extensões usadas
+ * por processos sejam deslocadas para o início da memória, mantendo sua ordem,
+ * enquanto o espaço livre fica reunido em uma única região no final.
  *
  * Seu principal objetivo é reduzir a fragmentação externa, criando um bloco 
  * contíguo maior de memória livre para facilitar futuras alocações.
  *
  * @note Esta operação não preserva a posição original dos processos na memória.
  */
-void compactar_memoria();
+void compactar_memoria(simulador_t *sim);
+
+/// Um trecho movido pela compactação incremental.
+typedef struct {
+    int pid;         ///< Processo dono do trecho
+    bloco_t antigo;  ///< Início antes do movimento
+    bloco_t novo;    ///< Início depois do movimento
+    bloco_t tamanho; ///< Número de blocos movidos
+} realocacao_t;
+
+/// Resultado de um passo de compactação incremental.
+typedef struct {
+    bloco_t movidos;           ///< Blocos movidos no passo (<= orçamento)
+    int concluida;             ///< 1 se não resta buraco antes de uma extensão ocupada
+    int quantidade;            ///< Número de realocações
+    int capacidade;            ///< Capacidade alocada do vetor `realocacoes`
+    realocacao_t *realocacoes; ///< Mapa de realocação (liberar com `free`)
+} passo_compactacao_t;
+
+/**
+ * @brief Move um trecho ocupado para o buraco imediatamente anterior a ele.
+ *
+ * Primitiva da compactação incremental: os `tamanho` primeiros blocos da
+ * extensão que começa em `origem` passam a começar em `destino`, onde
+ * [destino, origem) é uma região livre. Se o trecho encostar em uma extensão
+ * do mesmo processo, as duas são unidas; se for só parte da extensão, o
+ * restante continua como uma extensão separada.
+ *
+ * @return int 1 se o movimento foi feito, 0 se os parâmetros não descrevem
+ *         um buraco seguido de uma extensão com pelo menos `tamanho` blocos.
+ */
+int mover_extensao(simulador_t *sim, bloco_t origem, bloco_t destino, bloco_t tamanho);
+
+/**
+ * @brief Executa um passo de compactação que move no máximo `orcamento` blocos.
+ *
+ * Repetidamente pega o primeiro buraco da memória e desliza para dentro dele
+ * a extensão seguinte, unindo-a à anterior se for do mesmo processo. O
+ * orçamento é um limite rígido: da extensão que não cabe no que resta dele só
+ * o começo é movido, e o mapa registra esse trecho (com `tamanho` menor que a
+ * extensão; o restante segue em `antigo + tamanho`). O processo fica com duas
+ * extensões até o passo seguinte deslizar o restante para junto do trecho,
+ * que então as une. Não guarda
+ * estado entre passos: a fronteira é sempre o primeiro buraco, então os
+ * passos podem ser intercalados livremente com alocações e liberações.
+ *
+ * @param orcamento Máximo de blocos a mover (> 0).
+ * @param passo Recebe o total movido, se a compactação terminou e o mapa de
+ *        realocação; o chamador libera `passo->realocacoes`.
+ */
+void compactar_passo(simulador_t *sim, bloco_t orcamento, passo_compactacao_t *passo);
+
+/**
+ * @brief Muda o tamanho e, se preciso, a posição de uma extensão ocupada.
+ *
+ * Primitiva de `realocar_memoria`: a extensão que começa em `origem` passa a
+ * ocupar [destino, destino + tamanho). Fora da própria extensão, o novo
+ * intervalo só pode usar blocos livres; com `tamanho` 0, a extensão é
+ * liberada. A fragmentação interna de uma extensão buddy é descartada.
+ *
+ * @return int 1 se a extensão foi redimensionada, 0 se não houver extensão em
+ *         `origem` ou o novo intervalo não estiver livre.
+ */
+int redimensionar_extensao(simulador_t *sim, bloco_t origem, bloco_t destino, bloco_t tamanho);
+
+/**
+ * @brief Muda o tamanho de um processo alocado, movendo o mínimo de blocos.
+ *
+ * Encolher e crescer sobre a região livre seguinte são feitos no lugar. Se
+ * não houver espaço logo depois, um processo de uma só extensão pode deslizar
+ * para o início da região livre anterior; só então a estratégia `alocar`
+ * procura uma região nova, para onde todo o processo é copiado.
+ *
+ * @param pid Processo alocado.
+ * @param tamanho Novo tamanho total (> 0).
+ * @param alocar Estratégia usada quando o processo precisa mudar de lugar (NULL = não mudar);
+ *        com `buddy_fit`, a região nova é arredondada como numa alocação buddy.
+ * @return bloco_t Blocos copiados (0 se feito no lugar), ou -1 se o processo
+ *         não estiver alocado, o tamanho for inválido ou faltar espaço (nesse
+ *         caso a memória não é alterada).
+ */
+bloco_t realocar_memoria(simulador_t *sim, int pid, bloco_t tamanho, funcao_alocacao_t alocar);
 
 /**
  * @brief Analisa e exibe informações sobre fragmentação externa da memória.
  *
- * A função percorre a memória simulada e identifica:
+ * A função percorre as regiões livres da memória simulada e identifica:
  * - O número total de blocos livres.
  * - O número de regiões contíguas de memória livre.
  * - O tamanho da menor e da maior região livre.
@@ -78,25 +308,77 @@ void compactar_memoria();
  *
  * @note A saída é impressa diretamente no terminal.
  */
-void exibir_fragmentacao();
+void exibir_fragmentacao(simulador_t *sim);
+
+/**
+ * @brief Começa a recriar a memória a partir de extensões ocupadas.
+ *
+ * Usada pelos leitores de estado: chame `montar_extensao` para cada extensão,
+ * em ordem crescente de endereço, e depois `concluir_montagem`.
+ *
+ * @param tamanho Número de unidades da memória.
+ */
+void iniciar_montagem(simulador_t *sim, bloco_t tamanho);
+
+/**
+ * @brief Acrescenta uma extensão ocupada à memória em montagem.
+ * @param inicio Primeiro bloco da extensão.
+ * @param tamanho Número de blocos.
+ * @param pid Processo dono da extensão.
+ * @return int 1 se aceita, 0 se inválida, sobreposta ou fora de ordem.
+ */
+int montar_extensao(simulador_t *sim, bloco_t inicio, bloco_t tamanho, int pid);
+
+/**
+ * @brief Conclui a montagem, criando as regiões livres restantes.
+ */
+void concluir_montagem(simulador_t *sim);
+
+/// Estatísticas de fragmentação externa da memória.
+typedef struct {
+    bloco_t livres;  ///< Total de blocos livres
+    int regioes;     ///< Número de regiões livres
+    bloco_t maior;   ///< Tamanho da maior região livre (0 se não houver)
+    bloco_t menor;   ///< Tamanho da menor região livre (0 se não houver)
+    bloco_t interna; ///< Blocos ocupados por alocações buddy além do pedido
+    double indice;   ///< Índice de fragmentação: 1 - maior / livres (0 sem fragmentação)
+    int faixas;      ///< Faixas usadas do histograma (até a última não vazia)
+    int histograma[FAIXAS_HISTOGRAMA]; ///< Regiões livres com tamanho em [2^k, 2^(k+1))
+} fragmentacao_t;
+
+/**
+ * @brief Calcula as estatísticas de fragmentação externa da memória.
+ *
+ * Custa O(1): os valores são mantidos pelo índice de regiões livres a cada
+ * alocação, liberação e compactação.
+ *
+ * @param frag Estrutura que recebe as estatísticas.
+ */
+void calcular_fragmentacao(const simulador_t *sim, fragmentacao_t *frag);
 
 /**
  * @brief Carrega o estado da memória a partir de um arquivo.
- * @param arquivo Caminho do arquivo contendo os blocos da memória.
+ *
+ * Aceita tanto o formato bloco a bloco quanto o formato de extensões. No
+ * formato de extensões, o tamanho da memória é lido do próprio arquivo.
+ * Se o arquivo não existir ou for inválido, a memória fica como estava.
+ *
+ * @param arquivo Caminho do arquivo contendo o estado da memória.
+ * @return int 0 em caso de sucesso, -1 se o arquivo não pôde ser carregado.
  */
-void carregar_memoria(const char *arquivo);
+int carregar_memoria(simulador_t *sim, const char *arquivo);
 
 /**
  * @brief Verifica se um processo com o PID fornecido já está presente na memória.
  *
- * Percorre todos os blocos da memória simulada e verifica se algum deles está
- * ocupado pelo processo com o identificador especificado. Essa função é útil
+ * Consulta a tabela de processos para saber se algum bloco da memória simulada
+ * está ocupado pelo processo com o identificador especificado. Essa função é útil
  * para evitar múltiplas alocações do mesmo processo sem liberação prévia.
  *
  * @param pid Identificador do processo a ser verificado.
  * @return int Retorna 1 se o PID já está alocado, ou 0 caso contrário.
  */
-int pid_existe(int pid);
+int pid_existe(const simulador_t *sim, int pid);
 
 
 #endif // MEMORIA_H
@@ -0,0 +1,87 @@
+/**
+ * @file metricas.h
+ * @brief Contadores e histogramas de latência do caminho quente do alocador.
+ *
+ * Para cada estratégia de alocação são contados os pedidos, os sucessos e as
+ * falhas, as regiões livres visitadas pelas buscas e a soma dos tamanhos
+ * dessas regiões (ver `visitas_indice_t`), além de um histograma da latência
+ * de cada pedido. Liberações, compactações, realocações e lotes têm
+ * contadores próprios; a compactação conta também os blocos movidos, e a
+ * realocação os blocos copiados e os que ficaram no lugar (que liberar e
+ * alocar de novo teria copiado).
+ *
+ * As métricas ficam na simulação (ver `simulador_t`) e não usam travas: o
+ * custo por operação é o de duas leituras do relógio monotônico e alguns
+ * incrementos. A consulta é feita pelo comando `stats` ou, com a
+ * opção `--metricas` do processador, ao encerrar.
+ */
+
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <stdio.h>
+#include "bloco.h"
+#include "alocacao.h"
+
+/// Número de faixas do histograma de latência (faixa k: [2^k, 2^(k+1)) ns)
+#define FAIXAS_LATENCIA 32
+
+/// Contadores de um tipo de operação.
+typedef struct {
+    long chamadas;                     ///< Operações executadas
+    long sucessos;                     ///< Operações bem-sucedidas
+    long falhas;                       ///< Operações que falharam (alocação sem espaço)
+    long regioes_visitadas;            ///< Regiões livres visitadas pelas buscas
+    long blocos_examinados;            ///< Soma dos tamanhos das regiões visitadas
+    long latencia[FAIXAS_LATENCIA];    ///< Histograma da latência por operação
+} metricas_operacao_t;
+
+/// Todas as métricas de uma simulação.
+typedef struct {
+    metricas_operacao_t estrategias[NUM_ESTRATEGIAS]; ///< Na ordem de `nomes_estrategias`
+    metricas_operacao_t liberacoes;                    ///< Chamadas de `liberar_memoria`
+    metricas_operacao_t compactacoes;                  ///< Compactações completas e passos
+    metricas_operacao_t realocacoes;                   ///< Chamadas de `realocar_memoria`
+    metricas_operacao_t lotes;                         ///< Chamadas de `alocar_lote` (sucesso: lote todo atendido)
+    bloco_t movidos;                                   ///< Blocos movidos pelas compactações
+    bloco_t realocados;                                ///< Blocos copiados por `realocar_memoria`
+    bloco_t preservados;                               ///< Blocos que `realocar_memoria` manteve no lugar
+} metricas_t;
+
+/// Marca o início de uma operação medida (ver `metricas_registrar`).
+typedef struct {
+    long long ns;       ///< Relógio monotônico no início
+    long regioes;       ///< `visitas_indice.regioes` no início
+    long blocos;        ///< `visitas_indice.blocos` no início
+} marca_metrica_t;
+
+/**
+ * @brief Marca o início de uma operação.
+ */
+marca_metrica_t metricas_iniciar();
+
+/**
+ * @brief Conta uma operação iniciada em `marca`.
+ *
+ * @param op Contadores do tipo de operação.
+ * @param marca Valor devolvido por `metricas_iniciar` no início da operação.
+ * @param sucesso Se diferente de zero, conta um sucesso; senão, uma falha.
+ */
+void metricas_registrar(metricas_operacao_t *op, marca_metrica_t marca, int sucesso);
+
+/**
+ * @brief Zera as métricas.
+ */
+void metricas_zerar(metricas_t *metricas);
+
+/**
+ * @brief Escreve as métricas como um objeto JSON (sem quebra de linha).
+ *
+ * Cada operação vira `{"chamadas":..,"sucessos":..,"falhas":..,"regioes":..,
+ * "blocos":..,"latencia_ns":[...]}`, com o histograma cortado na última faixa
+ * não vazia. Estratégias nunca chamadas são omitidas. Seguem `movidos`,
+ * `realocados` e `preservados`.
+ */
+void metricas_json(const metricas_t *metricas, FILE *saida);
+
+#endif // METRICAS_H
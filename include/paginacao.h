@@ -0,0 +1,188 @@
+/**
+ * @file paginacao.h
+ * @brief Modelo alternativo de memória: paginação com TLB e substituição de páginas.
+ *
+ * A memória simulada (o mesmo `tamanho` do modelo contíguo) é dividida em
+ * quadros de `tamanho_pagina` unidades; o quadro `q` ocupa os blocos
+ * `[q * tamanho_pagina, (q + 1) * tamanho_pagina)`. Cada processo tem a sua
+ * tabela de páginas, e as páginas residentes de todos os processos disputam
+ * os mesmos quadros. Uma TLB totalmente associativa (substituição LRU) guarda
+ * as traduções mais recentes.
+ *
+ * Quando não há quadro livre, a vítima é escolhida por uma das políticas:
+ * - FIFO: a página carregada há mais tempo;
+ * - LRU: a página acessada há mais tempo;
+ * - Clock: segunda chance com bit de referência e ponteiro circular.
+ *
+ * Todas as operações de um acesso são O(1): as tabelas de páginas ficam
+ * juntas numa tabela hash com sondagem linear (apenas páginas residentes);
+ * FIFO, LRU e a própria TLB são listas duplamente encadeadas de quadros, e o
+ * Clock percorre o vetor de quadros. Como a TLB só traduz páginas residentes
+ * (a entrada é descartada quando a página sai), estar na TLB é um atributo do
+ * quadro, e a consulta à TLB custa o mesmo que a consulta à tabela.
+ */
+
+#ifndef PAGINACAO_H
+#define PAGINACAO_H
+
+#include "bloco.h"
+
+/// Tamanho de página padrão (em unidades)
+#define TAM_PAGINA_PADRAO 4
+
+/// Número padrão de entradas da TLB
+#define ENTRADAS_TLB_PADRAO 16
+
+/// Bits do número da página na chave de uma página (ver `chave_pagina`)
+#define BITS_PAGINA 40
+
+/// Política de substituição de páginas.
+typedef enum {
+    SUBSTITUICAO_FIFO,
+    SUBSTITUICAO_LRU,
+    SUBSTITUICAO_CLOCK,
+    NUM_SUBSTITUICOES
+} politica_substituicao_t;
+
+/// Nomes das políticas aceitos na linha de comando, na ordem do enum (terminado por NULL)
+extern const char *const nomes_substituicao[];
+
+/**
+ * @brief Converte o nome de uma política (`fifo`, `lru`, `clock`).
+ * @return int A política, ou -1 se o nome for desconhecido.
+ */
+int substituicao_por_nome(const char *nome);
+
+/// Elo de um quadro numa lista duplamente encadeada (-1 = fim).
+typedef struct {
+    int anterior, proximo;
+} elo_t;
+
+/// Extremos de uma lista de quadros (-1 = vazia).
+typedef struct {
+    int antigo;   ///< Primeiro quadro (o próximo a sair)
+    int novo;     ///< Último quadro (o mais recente)
+} lista_quadros_t;
+
+/// Quadro físico e a página que ele contém.
+typedef struct {
+    unsigned long long chave;  ///< Página residente (ver `chave_pagina`); 0 = quadro livre
+    unsigned char referencia;  ///< Bit de referência do Clock
+    unsigned char na_tlb;      ///< A tradução da página está na TLB
+} quadro_t;
+
+/// Contadores de uma simulação de paginação.
+typedef struct {
+    long acessos;        ///< Acessos reproduzidos
+    long acertos_tlb;    ///< Traduções encontradas na TLB
+    long faltas;         ///< Faltas de página (página não residente)
+    long substituicoes;  ///< Faltas que exigiram retirar uma página residente
+    long liberacoes;     ///< Processos encerrados (páginas descartadas)
+} contadores_paginacao_t;
+
+/// Estado de uma simulação de paginação.
+typedef struct {
+    bloco_t tamanho_pagina;
+    int num_quadros;
+    politica_substituicao_t politica;
+
+    quadro_t *quadros;
+    int *livres;                ///< Pilha de quadros livres
+    int num_livres;
+    elo_t *elos_fila;           ///< Ordem de carga (FIFO) ou de uso (LRU)
+    lista_quadros_t fila;
+    int ponteiro;               ///< Ponteiro do Clock
+
+    int *tabela;                ///< Tabelas de páginas: hash chave -> quadro (-1 = vazio)
+    unsigned long long mascara; ///< Capacidade da tabela - 1 (potência de 2)
+
+    int entradas_tlb;           ///< Capacidade da TLB
+    int ocupadas_tlb;           ///< Traduções na TLB
+    elo_t *elos_tlb;            ///< Ordem de uso das traduções da TLB (LRU)
+    lista_quadros_t tlb;
+
+    contadores_paginacao_t contadores;
+} paginacao_t;
+
+/**
+ * @brief Identifica a página `pagina` do processo `pid` (pid > 0).
+ *
+ * O PID ocupa os 24 bits altos e o número da página os `BITS_PAGINA` baixos;
+ * a chave nunca é 0, que marca entradas vazias. `paginacao_acessar` recusa
+ * páginas que não cabem nesses bits, para que duas páginas nunca se confundam.
+ */
+static inline unsigned long long chave_pagina(int pid, long long pagina) {
+    return ((unsigned long long)pid << BITS_PAGINA) | ((unsigned long long)pagina & ((1ULL << BITS_PAGINA) - 1));
+}
+
+/**
+ * @brief Cria uma simulação de paginação com todos os quadros livres.
+ *
+ * @param p Estrutura a inicializar; liberar com `paginacao_destruir`.
+ * @param tamanho_memoria Unidades da memória física.
+ * @param tamanho_pagina Unidades por página/quadro.
+ * @param entradas_tlb Número de entradas da TLB (0 = sem TLB).
+ * @param politica Política de substituição.
+ * @return int 0 em caso de sucesso, -1 se os parâmetros não derem ao menos um quadro.
+ */
+int paginacao_criar(paginacao_t *p, bloco_t tamanho_memoria, bloco_t tamanho_pagina,
+                    int entradas_tlb, politica_substituicao_t politica);
+
+/**
+ * @brief Libera as estruturas de uma simulação de paginação.
+ */
+void paginacao_destruir(paginacao_t *p);
+
+/**
+ * @brief Traduz um endereço virtual, carregando a página se necessário.
+ *
+ * @param pid Processo (> 0 e < 2^24); acessos com outros PIDs são ignorados.
+ * @param endereco Endereço virtual (>= 0), em unidades; acessos a páginas de
+ *        número >= 2^`BITS_PAGINA` também são ignorados.
+ * @return int Quadro onde a página está, ou -1 se o acesso foi ignorado.
+ */
+int paginacao_acessar(paginacao_t *p, int pid, bloco_t endereco);
+
+/**
+ * @brief Descarta todas as páginas de um processo, liberando seus quadros.
+ *
+ * Custa O(número de quadros): o encerramento de processos é raro perto dos acessos.
+ */
+void paginacao_liberar(paginacao_t *p, int pid);
+
+/// Referência de um trace de paginação.
+typedef struct {
+    int pid;            ///< Processo
+    bloco_t endereco;   ///< Endereço virtual, ou -1 para encerrar o processo
+} referencia_t;
+
+/// Sequência de referências lida de um arquivo.
+typedef struct {
+    referencia_t *referencias;
+    long quantidade;
+    long capacidade;
+} trace_paginacao_t;
+
+/**
+ * @brief Lê um trace de referências.
+ *
+ * Cada linha é `<pid> <endereço>` (decimal, ou hexadecimal com `0x`) ou
+ * `liberar <pid>`; linhas vazias, iniciadas por `#` ou inválidas são ignoradas.
+ *
+ * @param arquivo Caminho do trace (`-` para a entrada padrão).
+ * @param trace Recebe as referências; liberar com `trace_paginacao_liberar`.
+ * @return int 0 em caso de sucesso, -1 se o arquivo não puder ser aberto.
+ */
+int trace_paginacao_carregar(const char *arquivo, trace_paginacao_t *trace);
+
+/**
+ * @brief Libera as referências de um trace.
+ */
+void trace_paginacao_liberar(trace_paginacao_t *trace);
+
+/**
+ * @brief Reproduz todas as referências de um trace.
+ */
+void paginacao_reproduzir(paginacao_t *p, const trace_paginacao_t *trace);
+
+#endif // PAGINACAO_H
@@ -0,0 +1,47 @@
+/**
+ * @file servidor.h
+ * @brief Modo servidor do processador: memória residente atendendo clientes.
+ *
+ * Em vez de um processo por comando, o servidor mantém o estado da memória
+ * carregado e atende os comandos de `comandos.h` por um socket Unix local.
+ * Cada linha recebida gera uma linha de resposta (duas com `--alteracoes`
+ * para os comandos que mudam a memória e têm resposta própria).
+ */
+
+#ifndef SERVIDOR_H
+#define SERVIDOR_H
+
+#include "memoria.h"
+
+/// Número máximo de clientes conectados ao mesmo tempo
+#define MAX_CLIENTES 64
+
+/**
+ * @brief Faz SIGINT e SIGTERM pedirem o encerramento em vez de matar o processo.
+ *
+ * Usada pelos dois modos residentes (`--pipe` e `--servidor`), para que o
+ * estado seja gravado ao sair. Os tratadores não usam SA_RESTART: uma leitura
+ * bloqueada (`poll`, `fgets`) é interrompida com EINTR.
+ */
+void instalar_sinais_encerramento();
+
+/**
+ * @brief Indica se SIGINT ou SIGTERM chegou desde `instalar_sinais_encerramento`.
+ */
+int encerramento_pedido();
+
+/**
+ * @brief Atende clientes em um socket Unix até receber `desligar` ou um sinal.
+ *
+ * Vários clientes podem ficar conectados ao mesmo tempo; seus comandos são
+ * executados na ordem em que chegam. O comando `sair` encerra apenas a
+ * conexão do cliente que o enviou.
+ *
+ * @param sim Simulação mantida pelo servidor.
+ * @param caminho Caminho do socket a ser criado (um socket antigo é removido;
+ *        qualquer outro arquivo no caminho impede o início).
+ * @return int 0 ao encerrar normalmente, -1 se o socket não pôde ser criado.
+ */
+int servir_socket(simulador_t *sim, const char *caminho);
+
+#endif // SERVIDOR_H
@@ -0,0 +1,84 @@
+/**
+ * @file tabela_pid.h
+ * @brief Tabela que associa cada PID às extensões de memória que ele ocupa.
+ *
+ * Permite liberar um processo ou verificar sua existência em tempo
+ * proporcional ao número de extensões do próprio processo, sem percorrer
+ * a memória inteira.
+ */
+
+#ifndef TABELA_PID_H
+#define TABELA_PID_H
+
+#include "bloco.h"
+
+/// Trecho contíguo de memória ocupado por um processo.
+typedef struct {
+    bloco_t inicio;  ///< Primeiro bloco do trecho
+    bloco_t tamanho; ///< Número de blocos do trecho
+} extensao_t;
+
+/// Registro de um processo presente na memória.
+typedef struct entrada_pid {
+    int pid;                  ///< Identificador do processo
+    int quantidade;           ///< Número de extensões em uso
+    int capacidade;           ///< Capacidade alocada do vetor de extensões
+    extensao_t *extensoes;    ///< Extensões ocupadas pelo processo
+    struct entrada_pid *prox; ///< Próxima entrada no mesmo balde
+} entrada_pid_t;
+
+/// Tabela hash de processos (encadeamento separado).
+typedef struct {
+    entrada_pid_t **baldes; ///< Vetor de listas de entradas
+    int num_baldes;         ///< Número de baldes (potência de dois)
+    int quantidade;         ///< Número de processos registrados
+} tabela_pid_t;
+
+/**
+ * @brief Remove todos os processos da tabela, liberando sua memória.
+ * @param tabela Tabela a ser esvaziada.
+ */
+void tabela_limpar(tabela_pid_t *tabela);
+
+/**
+ * @brief Procura o registro de um processo.
+ * @return entrada_pid_t* Registro do processo ou NULL se ele não ocupar memória.
+ */
+entrada_pid_t *tabela_buscar(const tabela_pid_t *tabela, int pid);
+
+/**
+ * @brief Registra que um processo passou a ocupar um trecho de memória.
+ *
+ * @param tabela Tabela de processos.
+ * @param pid Identificador do processo.
+ * @param inicio Primeiro bloco ocupado.
+ * @param tamanho Número de blocos ocupados.
+ */
+void tabela_adicionar(tabela_pid_t *tabela, int pid, bloco_t inicio, bloco_t tamanho);
+
+/**
+ * @brief Procura a extensão de um processo que começa em `inicio`.
+ * @return extensao_t* Extensão encontrada (pode ser alterada no lugar) ou NULL.
+ */
+extensao_t *tabela_buscar_extensao(const tabela_pid_t *tabela, int pid, bloco_t inicio);
+
+/**
+ * @brief Remove uma única extensão de um processo.
+ *
+ * A ordem das demais extensões do processo não é preservada. Se era a
+ * última, o processo sai da tabela.
+ *
+ * @param tabela Tabela de processos.
+ * @param pid Identificador do processo.
+ * @param inicio Primeiro bloco da extensão a remover.
+ */
+void tabela_remover_extensao(tabela_pid_t *tabela, int pid, bloco_t inicio);
+
+/**
+ * @brief Remove o registro de um processo da tabela.
+ * @param tabela Tabela de processos.
+ * @param pid Identificador do processo a ser removido.
+ */
+void tabela_remover(tabela_pid_t *tabela, int pid);
+
+#endif // TABELA_PID_H
@@ -0,0 +1,56 @@
+/**
+ * @file varredura.h
+ * @brief Kernels vetorizados de varredura de vetores de PIDs (formato bloco a bloco).
+ *
+ * O formato de estado bloco a bloco descreve a memória como um vetor de
+ * inteiros, um por unidade (0 = livre). Para convertê-lo em extensões é
+ * preciso achar onde termina cada sequência de valores iguais. Estes kernels
+ * comparam vários blocos por instrução (AVX2: 8, SSE2: 4), com uma versão
+ * escalar de reserva; a implementação é escolhida em tempo de execução
+ * conforme a CPU.
+ */
+
+#ifndef VARREDURA_H
+#define VARREDURA_H
+
+#include <stddef.h>
+
+/**
+ * @brief Conta quantos elementos iniciais de `v` são iguais a `valor`.
+ *
+ * Com `valor` 0, é o comprimento da sequência de blocos livres; com um PID,
+ * o comprimento da extensão do processo.
+ *
+ * @param v Vetor de PIDs.
+ * @param n Número de elementos de `v`.
+ * @param valor Valor procurado.
+ * @return size_t Comprimento da sequência (n se todos forem iguais).
+ */
+size_t varredura_comprimento(const int *v, size_t n, int valor);
+
+/**
+ * @brief Retorna a posição do primeiro elemento de `v` igual a `valor`.
+ *
+ * @param v Vetor de PIDs.
+ * @param n Número de elementos de `v`.
+ * @param valor Valor procurado (0 para o primeiro bloco livre, ou um PID).
+ * @return size_t Posição encontrada, ou n se não houver.
+ */
+size_t varredura_procurar(const int *v, size_t n, int valor);
+
+/**
+ * @brief Retorna o nome da implementação em uso: "avx2", "sse2" ou "escalar".
+ */
+const char *varredura_implementacao();
+
+/**
+ * @brief Força uma implementação (usada por testes e benchmarks).
+ *
+ * Deve ser chamada antes de as threads de trabalho começarem a varrer.
+ *
+ * @param nome "avx2", "sse2" ou "escalar".
+ * @return int 0 se a implementação existir e for suportada pela CPU, -1 caso contrário.
+ */
+int varredura_selecionar(const char *nome);
+
+#endif // VARREDURA_H
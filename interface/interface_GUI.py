@@ -1,16 +1,30 @@
 import tkinter as tk
 import tkinter.messagebox as msgbox
+import bisect
+import json
 import os
 import subprocess
 
 # Configurações
-TAM_MEMORIA = 100
 COLUNAS = 20
+# Acima deste número de unidades, cada célula desenhada agrega várias unidades
+MAX_CELULAS = 2000
 DIR_BASE = os.path.abspath(os.path.join(os.path.dirname(__file__), "..", "build"))
 ARQUIVO_ESTADO = os.path.join(DIR_BASE, "estado.txt")
-ARQUIVO_COMANDO = os.path.join(DIR_BASE, "comando.txt")
 BIN_PROCESSADOR = os.path.join(DIR_BASE, "processador")
 
+# Processador residente (modo --pipe), iniciado uma única vez
+processador = None
+
+# Cópia local da memória: extensões ocupadas em ordem de endereço
+tam_memoria = 0
+inicios = []      # início de cada extensão, ordenado
+extensoes = {}    # início -> (tamanho, pid)
+
+# Células desenhadas: cada uma cobre `unidades_celula` unidades
+unidades_celula = 1
+celulas = []      # índice -> (retângulo, texto)
+
 # Cores por PID
 CORES = [
     "#D0D0D0", "#4DA6FF", "#5CD65C", "#FFD633", "#FF6666",
@@ -21,115 +35,177 @@ def mostrar_erro(mensagem):
     """Exibe um erro visual na interface."""
     msgbox.showerror("Erro", mensagem)
 
+def iniciar_processador():
+    """Inicia o processador em modo --pipe, mantendo a memória residente."""
+    global processador
+    processador = subprocess.Popen(
+        [BIN_PROCESSADOR, "--pipe", "--alteracoes", ARQUIVO_ESTADO],
+        stdin=subprocess.PIPE, stdout=subprocess.PIPE, text=True, bufsize=1
+    )
+
+def enviar_comando(comando):
+    """Envia uma linha ao processador e retorna a linha de resposta."""
+    processador.stdin.write(comando.strip() + "\n")
+    processador.stdin.flush()
+    return processador.stdout.readline().strip()
+
+def encerrar_processador():
+    """Pede ao processador que grave o estado e termine, e fecha a janela."""
+    if processador and processador.poll() is None:
+        enviar_comando("sair")
+        processador.stdin.close()
+        processador.wait()
+    root.destroy()
+
 def carregar_estado():
-    """Lê estado.txt e retorna vetor de memória."""
-    if not os.path.exists(ARQUIVO_ESTADO):
-        return [0] * TAM_MEMORIA
-    with open(ARQUIVO_ESTADO) as f:
-        blocos = list(map(int, f.read().split()))
-    return blocos + [0] * (TAM_MEMORIA - len(blocos))
-
-def escrever_comando(comando):
-    """Escreve uma instrução no comando.txt (a ser lida pelo programa C)."""
-    with open(ARQUIVO_COMANDO, "w") as f:
-        f.write(comando.strip() + "\n")
-
-def desenhar_memoria(memoria):
-    """Desenha blocos proporcionalmente ao tamanho da janela."""
+    """Consulta o processador e substitui a cópia local da memória."""
+    global tam_memoria, inicios, extensoes
+    # Resposta: estado <tamanho> [<inicio> <tamanho> <pid>]...
+    campos = list(map(int, enviar_comando("estado").split()[1:]))
+    tam_memoria = campos[0]
+    inicios = campos[1::3]
+    extensoes = {campos[i]: (campos[i + 1], campos[i + 2]) for i in range(1, len(campos) - 2, 3)}
+
+def aplicar_alteracao(inicio, tamanho, pid):
+    """Faz o trecho [inicio, inicio + tamanho) pertencer a `pid` (0 = livre)."""
+    fim = inicio + tamanho
+    k = bisect.bisect_right(inicios, inicio) - 1
+    if k < 0 or inicios[k] + extensoes[inicios[k]][0] <= inicio:
+        k += 1
+
+    # Remove as extensões sobrepostas, preservando as sobras fora do trecho
+    sobras = []
+    while k < len(inicios) and inicios[k] < fim:
+        ini = inicios.pop(k)
+        tam, dono = extensoes.pop(ini)
+        if ini < inicio:
+            sobras.append((ini, inicio - ini, dono))
+        if ini + tam > fim:
+            sobras.append((fim, ini + tam - fim, dono))
+    if pid != 0:
+        sobras.append((inicio, tamanho, pid))
+
+    for ini, tam, dono in sobras:
+        bisect.insort(inicios, ini)
+        extensoes[ini] = (tam, dono)
+
+def pid_da_celula(c):
+    """Retorna o PID que ocupa a maior parte da célula `c` (0 se a maior parte está livre)."""
+    a = c * unidades_celula
+    b = min(a + unidades_celula, tam_memoria)
+    ocupacao = {0: b - a}
+    k = max(bisect.bisect_right(inicios, a) - 1, 0)
+    while k < len(inicios) and inicios[k] < b:
+        ini = inicios[k]
+        tam, pid = extensoes[ini]
+        comum = min(ini + tam, b) - max(ini, a)
+        if comum > 0:
+            ocupacao[pid] = ocupacao.get(pid, 0) + comum
+            ocupacao[0] -= comum
+        k += 1
+    return max(ocupacao, key=ocupacao.get)
+
+def pintar_celula(c):
+    """Atualiza a cor e o rótulo de uma célula já desenhada."""
+    pid = pid_da_celula(c)
+    retangulo, texto = celulas[c]
+    canvas.itemconfig(retangulo, fill=CORES[pid] if pid < len(CORES) else "#888888")
+    canvas.itemconfig(texto, text=str(pid) if pid != 0 else "")
+
+def desenhar_memoria(evento=None):
+    """Recria as células proporcionalmente ao tamanho da janela."""
+    global unidades_celula, celulas
     canvas.delete("all")
+    celulas = []
+    if tam_memoria <= 0:
+        return
+
+    # Memórias grandes são agregadas: no máximo MAX_CELULAS células
+    unidades_celula = -(-tam_memoria // MAX_CELULAS)
+    num_celulas = -(-tam_memoria // unidades_celula)
+    colunas = COLUNAS if num_celulas <= 200 else 2 * COLUNAS if num_celulas <= 800 else 4 * COLUNAS
 
     largura = canvas.winfo_width()
     altura = canvas.winfo_height()
 
-    tam_bloco_x = largura / COLUNAS
-    linhas = TAM_MEMORIA // COLUNAS
+    tam_bloco_x = largura / colunas
+    linhas = -(-num_celulas // colunas)
     tam_bloco_y = altura / linhas
+    fonte = ("Arial", max(int(min(tam_bloco_x / 3, tam_bloco_y / 2)), 1))
 
-    for i, bloco in enumerate(memoria):
-        linha = i // COLUNAS
-        coluna = i % COLUNAS
+    for i in range(num_celulas):
+        linha = i // colunas
+        coluna = i % colunas
         x1 = coluna * tam_bloco_x
         y1 = linha * tam_bloco_y
         x2 = x1 + tam_bloco_x
         y2 = y1 + tam_bloco_y
 
-        cor = CORES[bloco] if bloco < len(CORES) else "#888888"
-        canvas.create_rectangle(x1, y1, x2, y2, fill=cor, outline="black")
+        retangulo = canvas.create_rectangle(x1, y1, x2, y2, outline="black")
+        texto = canvas.create_text((x1 + x2) / 2, (y1 + y2) / 2, font=fonte)
+        celulas.append((retangulo, texto))
+        pintar_celula(i)
 
-        if bloco != 0:
-            canvas.create_text((x1 + x2) / 2, (y1 + y2) / 2, text=str(bloco), font=("Arial", int(tam_bloco_y / 2)))
+def processar_resposta(resposta):
+    """Aplica as alterações de um `ok` e repinta só as células afetadas."""
+    # Resposta: ok [<inicio> <tamanho> <pid>]... ou "ok *" (reler o estado)
+    campos = resposta.split()[1:]
+    if campos == ["*"]:
+        carregar_estado()
+        desenhar_memoria()
+        return
 
-def calcular_fragmentacao(memoria):
-    """Calcula estatísticas de fragmentação externa."""
-    total_livres = memoria.count(0)
-    atual = 0
-    tamanhos = []
+    valores = list(map(int, campos))
+    afetadas = set()
+    for i in range(0, len(valores) - 2, 3):
+        inicio, tamanho, pid = valores[i:i + 3]
+        aplicar_alteracao(inicio, tamanho, pid)
+        afetadas.update(range(inicio // unidades_celula, (inicio + tamanho - 1) // unidades_celula + 1))
+    for c in afetadas:
+        if c < len(celulas):
+            pintar_celula(c)
 
-    for bloco in memoria:
-        if bloco == 0:
-            atual += 1
-        else:
-            if atual > 0:
-                tamanhos.append(atual)
-                atual = 0
-    if atual > 0:
-        tamanhos.append(atual)
-
-    num_regioes = len(tamanhos)
-    maior = max(tamanhos) if tamanhos else 0
-    menor = min(tamanhos) if tamanhos else 0
-    tem_fragmentacao = num_regioes > 1
-
-    return {
-        "livres": total_livres,
-        "regioes": num_regioes,
-        "maior": maior,
-        "menor": menor,
-        "fragmentado": tem_fragmentacao
-    }
+def consultar_estatisticas():
+    """Consulta as estatísticas de fragmentação mantidas pelo processador."""
+    # Resposta: uma linha JSON (ver comando `stats`)
+    return json.loads(enviar_comando("stats"))
 
 def atualizar():
-    """Atualiza a visualização da memória e a exibição de fragmentação."""
-    memoria = carregar_estado()
-    desenhar_memoria(memoria)
-
-    frag = calcular_fragmentacao(memoria)
+    """Atualiza a exibição de fragmentação (a memória é atualizada a cada comando)."""
+    frag = consultar_estatisticas()
     texto_frag = (
         f"Blocos Livres: {frag['livres']}\n"
         f"Regiões Livres: {frag['regioes']}\n"
         f"Maior Região: {frag['maior']} blocos\n"
         f"Menor Região: {frag['menor']} blocos\n"
-        f"Fragmentação Externa: {'SIM' if frag['fragmentado'] else 'NÃO'}"
+        f"Índice de Fragmentação: {frag['indice']:.2f}\n"
+        f"Fragmentação Externa: {'SIM' if frag['regioes'] > 1 else 'NÃO'}"
     )
+    if frag['interna'] > 0:
+        texto_frag += f"\nFragmentação Interna: {frag['interna']} blocos"
     label_fragmentacao.config(text=texto_frag)
 
     root.after(1000, atualizar)
 
 def alocar():
-    """Cria um comando de alocação e executa o processador."""
+    """Envia um comando de alocação ao processador."""
     pid = entry_pid.get()
     tamanho = entry_tamanho.get()
     algoritmo = var_algoritmo.get()
     if pid.isdigit() and tamanho.isdigit():
-        comando = f"alocar {pid} {tamanho} {algoritmo}"
-        escrever_comando(comando)
-        result = subprocess.run(
-            [BIN_PROCESSADOR, ARQUIVO_COMANDO, ARQUIVO_ESTADO],
-            capture_output=True, text=True
-        )
-        if "Erro" in result.stdout or "Erro" in result.stderr:
-            mensagem = result.stdout.strip() or result.stderr.strip()
-            mostrar_erro(mensagem)
+        resposta = enviar_comando(f"alocar {pid} {tamanho} {algoritmo}")
+        if resposta.startswith("erro"):
+            mostrar_erro("Erro: " + resposta[len("erro "):])
+        else:
+            processar_resposta(resposta)
     else:
         mostrar_erro("PID e Tamanho devem ser números inteiros.")
 
 def liberar():
-    """Cria um comando de liberação e executa o processador."""
+    """Envia um comando de liberação ao processador."""
     pid = entry_pid.get()
     if pid.isdigit():
-        comando = f"liberar {pid}"
-        escrever_comando(comando)
-        subprocess.run([BIN_PROCESSADOR, ARQUIVO_COMANDO, ARQUIVO_ESTADO])
+        processar_resposta(enviar_comando(f"liberar {pid}"))
     else:
         mostrar_erro("PID inválido. Digite um número inteiro.")
 
@@ -157,9 +233,12 @@ var_algoritmo = tk.StringVar(value="first")
 tk.Radiobutton(frame_controle, text="First Fit", variable=var_algoritmo, value="first").grid(row=0, column=4)
 tk.Radiobutton(frame_controle, text="Best Fit", variable=var_algoritmo, value="best").grid(row=0, column=5)
 tk.Radiobutton(frame_controle, text="Worst Fit", variable=var_algoritmo, value="worst").grid(row=0, column=6)
+tk.Radiobutton(frame_controle, text="Next Fit", variable=var_algoritmo, value="next").grid(row=0, column=7)
+tk.Radiobutton(frame_controle, text="Segregated", variable=var_algoritmo, value="seg").grid(row=0, column=8)
+tk.Radiobutton(frame_controle, text="Buddy", variable=var_algoritmo, value="buddy").grid(row=0, column=9)
 
-tk.Button(frame_controle, text="Alocar", width=10, command=alocar).grid(row=0, column=7, padx=10)
-tk.Button(frame_controle, text="Liberar", width=10, command=liberar).grid(row=0, column=8)
+tk.Button(frame_controle, text="Alocar", width=10, command=alocar).grid(row=0, column=10, padx=10)
+tk.Button(frame_controle, text="Liberar", width=10, command=liberar).grid(row=0, column=11)
 
 # === Visualização da memória (expansível) ===
 frame_memoria = tk.Frame(root)
@@ -167,6 +246,7 @@ frame_memoria.grid(row=1, column=0, sticky="nsew", padx=10)
 
 canvas = tk.Canvas(frame_memoria, bg="white", bd=1, relief="solid")
 canvas.grid(row=0, column=0, sticky="nsew")
+canvas.bind("<Configure>", desenhar_memoria)
 frame_memoria.grid_rowconfigure(0, weight=1)
 frame_memoria.grid_columnconfigure(0, weight=1)
 
@@ -177,5 +257,8 @@ label_fragmentacao = tk.Label(frame_info, text="", font=("Arial", 10), justify="
 label_fragmentacao.pack()
 
 # Atualização contínua
+iniciar_processador()
+root.protocol("WM_DELETE_WINDOW", encerrar_processador)
+carregar_estado()
 atualizar()
 root.mainloop()
@@ -1,4 +1,10 @@
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "../include/alocacao.h"
 #include "../include/memoria.h"
+#include "../include/buddy.h"
+#include "../include/metricas.h"
 
 /**
  * @brief Realiza a alocação de memória utilizando a estratégia First Fit.
@@ -13,122 +19,311 @@
  * - 1 se a alocação for bem-sucedida.
  * - 0 se não houver espaço suficiente disponível.
  *
- * A função percorre a memória linearmente e aloca o primeiro bloco contíguo 
- * de tamanho suficiente. Caso não encontre, retorna falha.
+ * A busca desce pela árvore de regiões livres ordenada por endereço, guiada
+ * pelo maior tamanho de cada subárvore, em O(log R) para R regiões livres.
  */
-int first_fit(int pid, int tamanho) {
-    int livres = 0, inicio = -1;
-
-    for (int i = 0; i < TAM_MEMORIA; i++) {
-        // Verifica se o bloco está livre
-        if (memoria[i] == 0) {
-            if (livres == 0) inicio = i; // marca o início do bloco livre
-            livres++;
-
-            // Se o número de blocos livres atingiu o necessário
-            if (livres == tamanho) {
-                // Aloca o bloco para o processo
-                for (int j = inicio; j < inicio + tamanho; j++)
-                    memoria[j] = pid;
-                return 1; // sucesso
-            }
-        } else {
-            // Bloco ocupado, reinicia a contagem
-            livres = 0;
-            inicio = -1;
-        }
-    }
+static int alocar_first(simulador_t *sim, int pid, bloco_t tamanho) {
+    if (tamanho <= 0) return 0;
+
+    no_livre_t *regiao = indice_primeiro(&sim->memoria.livres, tamanho);
+    if (!regiao) return 0; // falha na alocação
 
-    return 0; // falha na alocação
+    ocupar_regiao(sim, regiao, tamanho, pid);
+    return 1; // sucesso
 }
 
 /**
  * @brief Aloca memória usando a estratégia Best Fit.
  *
- * Procura o menor bloco livre contíguo que seja suficiente para o processo.
+ * Procura o menor bloco livre contíguo que seja suficiente para o processo,
+ * por meio de uma busca de limite inferior na árvore ordenada por tamanho.
  *
  * @param pid ID do processo a ser alocado.
  * @param tamanho Tamanho necessário em blocos.
  * @return 1 se alocou com sucesso, 0 se falhou.
  */
-int best_fit(int pid, int tamanho) {
-    int melhor_inicio = -1;
-    int melhor_tamanho = TAM_MEMORIA + 1;
-
-    int i = 0;
-    while (i < TAM_MEMORIA) {
-        // Encontrar início de um bloco livre
-        if (memoria[i] == 0) {
-            int inicio = i;
-            int livres = 0;
-
-            // Contar tamanho do bloco livre
-            while (i < TAM_MEMORIA && memoria[i] == 0) {
-                livres++;
-                i++;
-            }
-
-            // Se couber e for o melhor até agora
-            if (livres >= tamanho && livres < melhor_tamanho) {
-                melhor_inicio = inicio;
-                melhor_tamanho = livres;
-            }
-        } else {
-            i++;
-        }
-    }
-
-    // Aloca no melhor bloco encontrado
-    if (melhor_inicio != -1) {
-        for (int j = melhor_inicio; j < melhor_inicio + tamanho; j++) {
-            memoria[j] = pid;
-        }
-        return 1;
-    }
+static int alocar_best(simulador_t *sim, int pid, bloco_t tamanho) {
+    no_livre_t *regiao = indice_melhor(&sim->memoria.livres, tamanho);
+    if (!regiao) return 0;
 
-    return 0;
+    if (tamanho > 0)
+        ocupar_regiao(sim, regiao, tamanho, pid);
+    return 1;
 }
 
 /**
  * @brief Aloca memória usando a estratégia Worst Fit.
  *
  * Procura o maior bloco livre contíguo que seja suficiente para o processo.
+ * O maior tamanho livre fica na raiz da árvore por endereço, então basta
+ * descer até a primeira região com esse tamanho.
  *
  * @param pid ID do processo a ser alocado.
  * @param tamanho Tamanho necessário em blocos.
  * @return 1 se alocou com sucesso, 0 se falhou.
  */
-int worst_fit(int pid, int tamanho) {
-    int pior_inicio = -1;
-    int pior_tamanho = -1;
-
-    int i = 0;
-    while (i < TAM_MEMORIA) {
-        if (memoria[i] == 0) {
-            int inicio = i;
-            int livres = 0;
-
-            while (i < TAM_MEMORIA && memoria[i] == 0) {
-                livres++;
-                i++;
-            }
-
-            // Se for suficiente e maior que o pior atual
-            if (livres >= tamanho && livres > pior_tamanho) {
-                pior_inicio = inicio;
-                pior_tamanho = livres;
-            }
-        } else {
-            i++;
+static int alocar_worst(simulador_t *sim, int pid, bloco_t tamanho) {
+    no_livre_t *regiao = indice_maior(&sim->memoria.livres, tamanho);
+    if (!regiao) return 0;
+
+    if (tamanho > 0)
+        ocupar_regiao(sim, regiao, tamanho, pid);
+    return 1;
+}
+
+/**
+ * @brief Aloca memória usando a estratégia Next Fit.
+ *
+ * Procura a primeira região adequada que começa no ponteiro rotativo ou
+ * depois; se não houver, procura desde o bloco 0. A região que contém o
+ * ponteiro mas começa antes dele só é considerada na volta.
+ *
+ * @param pid ID do processo a ser alocado.
+ * @param tamanho Tamanho necessário em blocos.
+ * @return 1 se alocou com sucesso, 0 se falhou.
+ */
+static int alocar_next(simulador_t *sim, int pid, bloco_t tamanho) {
+    if (tamanho <= 0) return 0;
+
+    sim->next.pedidos++;
+    no_livre_t *regiao = indice_primeiro_apos(&sim->memoria.livres, sim->next.ponteiro, tamanho, &sim->next.examinados);
+    if (!regiao && sim->next.ponteiro > 0)
+        regiao = indice_primeiro_apos(&sim->memoria.livres, 0, tamanho, &sim->next.examinados);
+    if (!regiao) return 0;
+
+    sim->next.ponteiro = regiao->inicio + tamanho;
+    ocupar_regiao(sim, regiao, tamanho, pid);
+    return 1;
+}
+
+double next_fit_media_examinados(const simulador_t *sim) {
+    return sim->next.pedidos ? (double)sim->next.examinados / sim->next.pedidos : 0.0;
+}
+
+/**
+ * @brief Aloca memória usando listas segregadas por classe de tamanho.
+ *
+ * Como as classes pequenas têm tamanho exato, qualquer região da menor classe
+ * não vazia >= pedido serve, sem percorrer a lista. Só os pedidos que não
+ * cabem em nenhuma região pequena descem pela árvore por tamanho.
+ *
+ * @param pid ID do processo a ser alocado.
+ * @param tamanho Tamanho necessário em blocos.
+ * @return 1 se alocou com sucesso, 0 se falhou.
+ */
+static int alocar_segregado(simulador_t *sim, int pid, bloco_t tamanho) {
+    if (tamanho <= 0) return 0;
+
+    no_livre_t *regiao = indice_segregado(&sim->memoria.livres, tamanho);
+    if (!regiao) return alocar_best(sim, pid, tamanho);
+
+    ocupar_regiao(sim, regiao, tamanho, pid);
+    return 1;
+}
+
+/**
+ * @brief Aloca memória usando o sistema buddy.
+ *
+ * Busca um bloco livre da menor ordem >= k, onde 2^k é o pedido arredondado
+ * para potência de dois. Ao ocupar os 2^k primeiros blocos dele, o gancho
+ * `buddy_ocupacao` devolve as metades direitas das divisões às listas.
+ *
+ * @param pid ID do processo a ser alocado.
+ * @param tamanho Tamanho necessário em blocos.
+ * @return 1 se alocou com sucesso, 0 se falhou.
+ */
+static int alocar_buddy(simulador_t *sim, int pid, bloco_t tamanho) {
+    if (tamanho <= 0) return 0;
+
+    int ordem = buddy_ordem(tamanho);
+    bloco_buddy_t *bloco = buddy_buscar(sim, ordem);
+    if (!bloco) return 0;
+
+    bloco_t inicio = bloco->inicio;
+    bloco_t tam_bloco = (bloco_t)1 << ordem;
+    if (!ocupar_intervalo(sim, inicio, tam_bloco, pid)) return 0;
+
+    buddy_registrar_desperdicio(sim, inicio, tam_bloco - tamanho);
+    return 1;
+}
+
+/// Executa a estratégia `estrategia` contando o pedido nas métricas da thread.
+static int medir(simulador_t *sim, int estrategia, funcao_alocacao_t alocar, int pid, bloco_t tamanho) {
+    marca_metrica_t marca = metricas_iniciar();
+    int sucesso = alocar(sim, pid, tamanho);
+    metricas_registrar(&sim->metricas.estrategias[estrategia], marca, sucesso);
+    return sucesso;
+}
+
+int first_fit(simulador_t *sim, int pid, bloco_t tamanho) {
+    return medir(sim, ESTRATEGIA_FIRST, alocar_first, pid, tamanho);
+}
+
+int best_fit(simulador_t *sim, int pid, bloco_t tamanho) {
+    return medir(sim, ESTRATEGIA_BEST, alocar_best, pid, tamanho);
+}
+
+int worst_fit(simulador_t *sim, int pid, bloco_t tamanho) {
+    return medir(sim, ESTRATEGIA_WORST, alocar_worst, pid, tamanho);
+}
+
+int next_fit(simulador_t *sim, int pid, bloco_t tamanho) {
+    return medir(sim, ESTRATEGIA_NEXT, alocar_next, pid, tamanho);
+}
+
+int segregado_fit(simulador_t *sim, int pid, bloco_t tamanho) {
+    return medir(sim, ESTRATEGIA_SEG, alocar_segregado, pid, tamanho);
+}
+
+int buddy_fit(simulador_t *sim, int pid, bloco_t tamanho) {
+    return medir(sim, ESTRATEGIA_BUDDY, alocar_buddy, pid, tamanho);
+}
+
+/// Chave de ordenação de um pedido do lote.
+typedef struct {
+    long long chave;  ///< Tamanho ou PID, conforme a ordenação
+    int indice;       ///< Posição do pedido no lote
+} ordem_lote_t;
+
+/// Maiores pedidos primeiro; empates na ordem do lote.
+static int comparar_decrescente(const void *a, const void *b) {
+    const ordem_lote_t *x = a, *y = b;
+    if (x->chave != y->chave) return x->chave < y->chave ? 1 : -1;
+    return x->indice - y->indice;
+}
+
+/// PIDs em ordem crescente; empates na ordem do lote.
+static int comparar_crescente(const void *a, const void *b) {
+    const ordem_lote_t *x = a, *y = b;
+    if (x->chave != y->chave) return x->chave < y->chave ? -1 : 1;
+    return x->indice - y->indice;
+}
+
+/// Marca de posição atendida ou inválida na árvore do lote
+#define SEM_PEDIDO LLONG_MAX
+
+/// Árvore de mínimos dos tamanhos pendentes, folhas na ordem de atendimento.
+typedef struct {
+    bloco_t *minimo;  ///< Nó k tem filhos 2k e 2k + 1; a folha da posição i é `folhas + i`
+    int folhas;       ///< Potência de dois >= número de pedidos
+} arvore_lote_t;
+
+/// Retira a posição `i` da árvore.
+static void arvore_retirar(arvore_lote_t *a, int i) {
+    int k = a->folhas + i;
+    a->minimo[k] = SEM_PEDIDO;
+    for (k /= 2; k >= 1; k /= 2)
+        a->minimo[k] = a->minimo[2 * k] < a->minimo[2 * k + 1] ? a->minimo[2 * k] : a->minimo[2 * k + 1];
+}
+
+/// Primeira posição (na ordem de atendimento) com tamanho <= `limite`, ou -1.
+static int arvore_primeira(const arvore_lote_t *a, bloco_t limite) {
+    if (a->minimo[1] > limite) return -1;
+    int k = 1;
+    while (k < a->folhas) k = a->minimo[2 * k] <= limite ? 2 * k : 2 * k + 1;
+    return k - a->folhas;
+}
+
+/**
+ * @brief Coloca os pedidos válidos do lote com First Fit, numa só passagem.
+ *
+ * A passagem avança por endereço. Cada região visitada recebe, em ordem de
+ * atendimento, os pendentes que cabem no que sobrou dela; o que sobra ao
+ * final é menor que qualquer pendente, e como os pendentes só diminuem,
+ * nenhuma região deixada para trás voltaria a servir. Por isso o resultado
+ * coincide com o do First Fit pedido a pedido.
+ *
+ * Cada pedido é contado nas métricas do First Fit como se tivesse sido
+ * feito sozinho: as regiões visitadas e o tempo desde a colocação anterior
+ * vão para a colocação seguinte, e o resto da passagem para as falhas.
+ */
+static void varrer_first(simulador_t *sim, pedido_lote_t *pedidos, const ordem_lote_t *ordem,
+                         const char *valido, int quantidade) {
+    arvore_lote_t a = { NULL, 1 };
+    while (a.folhas < quantidade) a.folhas *= 2;
+    a.minimo = malloc(2 * a.folhas * sizeof(bloco_t));
+    for (int i = 0; i < a.folhas; i++)
+        a.minimo[a.folhas + i] = i < quantidade && valido[ordem[i].indice] ? pedidos[ordem[i].indice].tamanho : SEM_PEDIDO;
+    for (int k = a.folhas - 1; k >= 1; k--)
+        a.minimo[k] = a.minimo[2 * k] < a.minimo[2 * k + 1] ? a.minimo[2 * k] : a.minimo[2 * k + 1];
+
+    metricas_operacao_t *op = &sim->metricas.estrategias[ESTRATEGIA_FIRST];
+    marca_metrica_t marca = metricas_iniciar();
+    bloco_t posicao = 0;
+    no_livre_t *regiao;
+    while (a.minimo[1] != SEM_PEDIDO &&
+           (regiao = indice_primeiro_apos(&sim->memoria.livres, posicao, a.minimo[1], NULL))) {
+        bloco_t resto = regiao->tamanho;
+        int i;
+        while ((i = arvore_primeira(&a, resto)) >= 0) {
+            pedido_lote_t *p = &pedidos[ordem[i].indice];
+            p->inicio = regiao->inicio;
+            posicao = p->inicio + p->tamanho;
+            resto -= p->tamanho;
+            arvore_retirar(&a, i);
+            // A região é liberada quando fica toda ocupada
+            ocupar_regiao(sim, regiao, p->tamanho, p->pid);
+            metricas_registrar(op, marca, 1);
+            marca = metricas_iniciar();
+            if (resto == 0) break;
+        }
+    }
+
+    // Os pendentes que sobraram não cabem em nenhuma região
+    for (int i = 0; i < quantidade; i++)
+        if (a.minimo[a.folhas + i] != SEM_PEDIDO) {
+            metricas_registrar(op, marca, 0);
+            marca = metricas_iniciar();
         }
+    free(a.minimo);
+}
+
+int alocar_lote(simulador_t *sim, pedido_lote_t *pedidos, int quantidade, funcao_alocacao_t alocar, int ordenar) {
+    marca_metrica_t marca = metricas_iniciar();
+    ordem_lote_t *ordem = malloc((quantidade ? quantidade : 1) * sizeof(ordem_lote_t));
+    char *valido = malloc(quantidade ? quantidade : 1);
+    int atendidos = 0;
+
+    // Só a primeira ocorrência de cada PID no lote vale
+    for (int i = 0; i < quantidade; i++) ordem[i] = (ordem_lote_t){ pedidos[i].pid, i };
+    qsort(ordem, quantidade, sizeof(ordem_lote_t), comparar_crescente);
+    for (int i = 0; i < quantidade; i++) {
+        const pedido_lote_t *p = &pedidos[ordem[i].indice];
+        valido[ordem[i].indice] = p->pid > 0 && p->tamanho > 0 && (i == 0 || ordem[i - 1].chave != p->pid) &&
+                                  !pid_existe(sim, p->pid) && !espera_contem(sim, p->pid);
+        pedidos[i].inicio = -1;
     }
 
-    if (pior_inicio != -1) {
-        for (int j = pior_inicio; j < pior_inicio + tamanho; j++) {
-            memoria[j] = pid;
+    for (int i = 0; i < quantidade; i++) ordem[i] = (ordem_lote_t){ pedidos[i].tamanho, i };
+    if (ordenar) qsort(ordem, quantidade, sizeof(ordem_lote_t), comparar_decrescente);
+
+    if (alocar == first_fit) {
+        varrer_first(sim, pedidos, ordem, valido, quantidade);
+    } else {
+        for (int i = 0; i < quantidade; i++) {
+            pedido_lote_t *p = &pedidos[ordem[i].indice];
+            if (valido[ordem[i].indice] && alocar(sim, p->pid, p->tamanho))
+                p->inicio = tabela_buscar(&sim->memoria.processos, p->pid)->extensoes[0].inicio;
         }
-        return 1;
     }
 
-    return 0;
-}
\ No newline at end of file
+    for (int i = 0; i < quantidade; i++)
+        if (pedidos[i].inicio >= 0) atendidos++;
+    free(ordem);
+    free(valido);
+    metricas_registrar(&sim->metricas.lotes, marca, atendidos == quantidade);
+    return atendidos;
+}
+
+const char *const nomes_estrategias[] = { "first", "best", "worst", "next", "seg", "buddy", NULL };
+
+/// Funções das estratégias, na mesma ordem de `nomes_estrategias`
+static const funcao_alocacao_t funcoes_estrategias[NUM_ESTRATEGIAS] = {
+    first_fit, best_fit, worst_fit, next_fit, segregado_fit, buddy_fit,
+};
+
+funcao_alocacao_t estrategia_por_nome(const char *nome) {
+    for (int k = 0; nomes_estrategias[k]; k++)
+        if (strcmp(nomes_estrategias[k], nome) == 0) return funcoes_estrategias[k];
+    return NULL;
+}
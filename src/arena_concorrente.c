@@ -0,0 +1,208 @@
+/**
+ * @file arena_concorrente.c
+ * @brief Implementação da memória simulada concorrente, fragmentada por endereço.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "../include/arena_concorrente.h"
+
+/// Contador usado para distribuir as threads entre os fragmentos
+static int proxima_thread = 0;
+
+/// Número sequencial da thread atual (-1 até a primeira alocação)
+static _Thread_local int numero_thread = -1;
+
+static int fragmento_de_casa(const arena_concorrente_t *arena) {
+    if (numero_thread < 0)
+        numero_thread = __atomic_fetch_add(&proxima_thread, 1, __ATOMIC_RELAXED);
+    return numero_thread % arena->num_fragmentos;
+}
+
+/// Fragmento que contém o bloco `endereco`.
+static fragmento_t *fragmento_do_endereco(arena_concorrente_t *arena, bloco_t endereco) {
+    bloco_t largura = arena->tamanho / arena->num_fragmentos;
+    bloco_t f = endereco / largura;
+    if (f >= arena->num_fragmentos) f = arena->num_fragmentos - 1;
+    return &arena->fragmentos[f];
+}
+
+static tabela_fragmento_t *tabela_do_pid(arena_concorrente_t *arena, int pid) {
+    unsigned h = (unsigned)pid * 2654435761u;
+    return &arena->tabelas[h % (unsigned)arena->num_tabelas];
+}
+
+int arena_criar(arena_concorrente_t *arena, bloco_t tamanho, int num_fragmentos) {
+    if (tamanho <= 0 || num_fragmentos <= 0 || num_fragmentos > tamanho)
+        return -1;
+
+    arena->tamanho = tamanho;
+    arena->num_fragmentos = num_fragmentos;
+    arena->atravessadas = 0;
+    arena->fragmentos = aligned_alloc(64, num_fragmentos * sizeof(fragmento_t));
+    arena->num_tabelas = num_fragmentos;
+    arena->tabelas = aligned_alloc(64, num_fragmentos * sizeof(tabela_fragmento_t));
+
+    bloco_t largura = tamanho / num_fragmentos;
+    for (int f = 0; f < num_fragmentos; f++) {
+        fragmento_t *frag = &arena->fragmentos[f];
+        memset(frag, 0, sizeof(*frag));
+        pthread_mutex_init(&frag->trava, NULL);
+        frag->inicio = f * largura;
+        frag->fim = (f == num_fragmentos - 1) ? tamanho : (f + 1) * largura;
+        indice_liberar(&frag->livres, frag->inicio, frag->fim - frag->inicio);
+
+        tabela_fragmento_t *tab = &arena->tabelas[f];
+        memset(tab, 0, sizeof(*tab));
+        pthread_mutex_init(&tab->trava, NULL);
+    }
+    return 0;
+}
+
+void arena_destruir(arena_concorrente_t *arena) {
+    for (int f = 0; f < arena->num_fragmentos; f++) {
+        indice_limpar(&arena->fragmentos[f].livres);
+        pthread_mutex_destroy(&arena->fragmentos[f].trava);
+    }
+    for (int t = 0; t < arena->num_tabelas; t++) {
+        tabela_limpar(&arena->tabelas[t].processos);
+        free(arena->tabelas[t].processos.baldes);
+        pthread_mutex_destroy(&arena->tabelas[t].trava);
+    }
+    free(arena->fragmentos);
+    free(arena->tabelas);
+    arena->fragmentos = NULL;
+    arena->tabelas = NULL;
+}
+
+/// Tenta alocar no fragmento, que deve estar travado pelo chamador.
+static bloco_t alocar_no_fragmento(fragmento_t *frag, bloco_t tamanho, int roubo) {
+    no_livre_t *regiao = indice_primeiro(&frag->livres, tamanho);
+    if (!regiao) return -1;
+
+    bloco_t inicio = regiao->inicio;
+    indice_ocupar(&frag->livres, regiao, tamanho);
+    frag->alocacoes++;
+    if (roubo) frag->roubos++;
+    return inicio;
+}
+
+/**
+ * @brief Aloca um trecho que pode atravessar fronteiras entre fragmentos.
+ *
+ * Trava todos os fragmentos, sempre em ordem de endereço (os demais caminhos
+ * seguram no máximo uma trava de fragmento por vez, então não há impasse), e
+ * procura o primeiro trecho livre contíguo: uma região que encosta no fim de
+ * um fragmento continua na região que começa no início do seguinte.
+ */
+static bloco_t alocar_atravessando(arena_concorrente_t *arena, bloco_t tamanho) {
+    int n = arena->num_fragmentos;
+    for (int f = 0; f < n; f++) pthread_mutex_lock(&arena->fragmentos[f].trava);
+
+    bloco_t inicio = -1, corrida = 0;
+    int primeiro = 0;
+    for (int f = 0; f < n && corrida < tamanho; f++) {
+        fragmento_t *frag = &arena->fragmentos[f];
+        no_livre_t *r = corrida > 0 ? indice_contendo(&frag->livres, frag->inicio) : NULL;
+        if (r) {
+            corrida += r->tamanho;
+            // Fragmento todo livre: o trecho pode continuar no próximo
+            if (corrida >= tamanho || r->tamanho == frag->fim - frag->inicio) continue;
+        }
+        // Recomeça na região livre que encosta no fim do fragmento, se houver
+        r = indice_contendo(&frag->livres, frag->fim - 1);
+        inicio = r ? r->inicio : -1;
+        corrida = r ? r->tamanho : 0;
+        primeiro = f;
+    }
+
+    if (corrida >= tamanho) {
+        for (int f = primeiro; f < n && arena->fragmentos[f].inicio < inicio + tamanho; f++) {
+            fragmento_t *frag = &arena->fragmentos[f];
+            bloco_t de = inicio > frag->inicio ? inicio : frag->inicio;
+            bloco_t ate = inicio + tamanho < frag->fim ? inicio + tamanho : frag->fim;
+            indice_reservar(&frag->livres, de, ate - de);
+        }
+        arena->fragmentos[primeiro].alocacoes++;
+        arena->atravessadas++;
+    } else {
+        inicio = -1;
+    }
+
+    for (int f = n - 1; f >= 0; f--) pthread_mutex_unlock(&arena->fragmentos[f].trava);
+    return inicio;
+}
+
+bloco_t arena_alocar(arena_concorrente_t *arena, bloco_t tamanho) {
+    if (tamanho <= 0) return -1;
+
+    int casa = fragmento_de_casa(arena);
+    fragmento_t *frag = &arena->fragmentos[casa];
+
+    pthread_mutex_lock(&frag->trava);
+    bloco_t inicio = alocar_no_fragmento(frag, tamanho, 0);
+    pthread_mutex_unlock(&frag->trava);
+    if (inicio >= 0) return inicio;
+
+    // Roubo: primeiro só os fragmentos livres de disputa, depois todos
+    for (int passada = 0; passada < 2; passada++) {
+        for (int k = 1; k < arena->num_fragmentos; k++) {
+            frag = &arena->fragmentos[(casa + k) % arena->num_fragmentos];
+            if (passada == 0) {
+                if (pthread_mutex_trylock(&frag->trava) != 0) continue;
+            } else {
+                pthread_mutex_lock(&frag->trava);
+            }
+            inicio = alocar_no_fragmento(frag, tamanho, 1);
+            pthread_mutex_unlock(&frag->trava);
+            if (inicio >= 0) return inicio;
+        }
+    }
+
+    // Nenhum fragmento sozinho basta: resta um trecho que atravesse fronteiras
+    return arena->num_fragmentos > 1 ? alocar_atravessando(arena, tamanho) : -1;
+}
+
+void arena_liberar(arena_concorrente_t *arena, bloco_t inicio, bloco_t tamanho) {
+    // Um trecho que atravessa fronteiras volta a cada fragmento, uma trava por vez
+    while (tamanho > 0) {
+        fragmento_t *frag = fragmento_do_endereco(arena, inicio);
+        bloco_t parte = frag->fim - inicio < tamanho ? frag->fim - inicio : tamanho;
+        pthread_mutex_lock(&frag->trava);
+        indice_liberar(&frag->livres, inicio, parte);
+        pthread_mutex_unlock(&frag->trava);
+        inicio += parte;
+        tamanho -= parte;
+    }
+}
+
+int arena_alocar_pid(arena_concorrente_t *arena, int pid, bloco_t tamanho) {
+    bloco_t inicio = arena_alocar(arena, tamanho);
+    if (inicio < 0) return 0;
+
+    tabela_fragmento_t *tab = tabela_do_pid(arena, pid);
+    pthread_mutex_lock(&tab->trava);
+    tabela_adicionar(&tab->processos, pid, inicio, tamanho);
+    pthread_mutex_unlock(&tab->trava);
+    return 1;
+}
+
+void arena_liberar_pid(arena_concorrente_t *arena, int pid) {
+    tabela_fragmento_t *tab = tabela_do_pid(arena, pid);
+
+    // Retira o processo da tabela e só depois devolve o espaço, sem as duas travas juntas
+    pthread_mutex_lock(&tab->trava);
+    entrada_pid_t *e = tabela_buscar(&tab->processos, pid);
+    int quantidade = e ? e->quantidade : 0;
+    extensao_t *extensoes = NULL;
+    if (quantidade) {
+        extensoes = malloc(quantidade * sizeof(extensao_t));
+        memcpy(extensoes, e->extensoes, quantidade * sizeof(extensao_t));
+        tabela_remover(&tab->processos, pid);
+    }
+    pthread_mutex_unlock(&tab->trava);
+
+    for (int k = 0; k < quantidade; k++)
+        arena_liberar(arena, extensoes[k].inicio, extensoes[k].tamanho);
+    free(extensoes);
+}
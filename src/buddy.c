@@ -0,0 +1,243 @@
+/**
+ * @file buddy.c
+ * @brief Implementação das listas livres por ordem do sistema buddy.
+ *
+ * Invariante: os blocos das listas cobrem exatamente o espaço livre da
+ * memória e nenhum bloco tem o seu buddy também livre (se tivesse, os dois
+ * teriam sido fundidos). Dividir e fundir custam O(log N) blocos.
+ */
+
+#include <stdlib.h>
+#include "../include/buddy.h"
+#include "../include/memoria.h"
+
+/// Estado do gerador pseudoaleatório das prioridades (xorshift32), um por thread
+static _Thread_local unsigned semente = 521288629u;
+
+static unsigned proxima_prioridade() {
+    semente ^= semente << 13;
+    semente ^= semente >> 17;
+    semente ^= semente << 5;
+    return semente;
+}
+
+static bloco_t tamanho_ordem(int ordem) {
+    return (bloco_t)1 << ordem;
+}
+
+/* ---------------- Treap por endereço ---------------- */
+
+static void dividir(bloco_buddy_t *t, bloco_t chave, bloco_buddy_t **esq, bloco_buddy_t **dir) {
+    if (!t) {
+        *esq = *dir = NULL;
+    } else if (t->inicio < chave) {
+        dividir(t->dir, chave, &t->dir, dir);
+        *esq = t;
+    } else {
+        dividir(t->esq, chave, esq, &t->esq);
+        *dir = t;
+    }
+}
+
+static bloco_buddy_t *juntar(bloco_buddy_t *a, bloco_buddy_t *b) {
+    if (!a) return b;
+    if (!b) return a;
+    if (a->prioridade > b->prioridade) {
+        a->dir = juntar(a->dir, b);
+        return a;
+    }
+    b->esq = juntar(a, b->esq);
+    return b;
+}
+
+static bloco_buddy_t *inserir(bloco_buddy_t *t, bloco_buddy_t *no) {
+    if (!t) return no;
+    if (no->prioridade > t->prioridade) {
+        dividir(t, no->inicio, &no->esq, &no->dir);
+        return no;
+    }
+    if (no->inicio < t->inicio)
+        t->esq = inserir(t->esq, no);
+    else
+        t->dir = inserir(t->dir, no);
+    return t;
+}
+
+static bloco_buddy_t *remover(bloco_buddy_t *t, bloco_t inicio) {
+    if (!t) return NULL;
+    if (t->inicio == inicio)
+        return juntar(t->esq, t->dir);
+    if (inicio < t->inicio)
+        t->esq = remover(t->esq, inicio);
+    else
+        t->dir = remover(t->dir, inicio);
+    return t;
+}
+
+/// Último bloco que começa em `endereco` ou antes.
+static bloco_buddy_t *anterior_ou_igual(const listas_buddy_t *b, bloco_t endereco) {
+    bloco_buddy_t *t = b->raiz, *candidato = NULL;
+    while (t) {
+        if (t->inicio <= endereco) {
+            candidato = t;
+            t = t->dir;
+        } else {
+            t = t->esq;
+        }
+    }
+    return candidato;
+}
+
+static void liberar_nos(bloco_buddy_t *no) {
+    if (!no) return;
+    liberar_nos(no->esq);
+    liberar_nos(no->dir);
+    free(no);
+}
+
+/* ---------------- Listas por ordem ---------------- */
+
+static void adicionar(listas_buddy_t *b, bloco_t inicio, int ordem) {
+    bloco_buddy_t *no = malloc(sizeof(bloco_buddy_t));
+    no->inicio = inicio;
+    no->ordem = ordem;
+    no->prioridade = proxima_prioridade();
+    no->esq = no->dir = NULL;
+    b->raiz = inserir(b->raiz, no);
+
+    no->ant = NULL;
+    no->prox = b->listas[ordem];
+    if (b->listas[ordem]) b->listas[ordem]->ant = no;
+    b->listas[ordem] = no;
+}
+
+/// Retira o bloco da treap e da lista da sua ordem e o libera.
+static void retirar(listas_buddy_t *b, bloco_buddy_t *no) {
+    b->raiz = remover(b->raiz, no->inicio);
+    if (no->ant) no->ant->prox = no->prox;
+    else b->listas[no->ordem] = no->prox;
+    if (no->prox) no->prox->ant = no->ant;
+    free(no);
+}
+
+/// Devolve um bloco livre, fundindo-o com o buddy enquanto este estiver livre.
+static void devolver(listas_buddy_t *b, bloco_t inicio, int ordem) {
+    while (ordem < ORDEM_MAXIMA_BUDDY) {
+        bloco_t buddy = inicio ^ tamanho_ordem(ordem);
+        bloco_buddy_t *no = anterior_ou_igual(b, buddy);
+        if (!no || no->inicio != buddy || no->ordem != ordem) break;
+
+        retirar(b, no);
+        if (buddy < inicio) inicio = buddy;
+        ordem++;
+    }
+    adicionar(b, inicio, ordem);
+}
+
+/**
+ * Decompõe [inicio, fim) nos maiores blocos alinhados possíveis. Com `fundir`,
+ * cada bloco é fundido com os buddies livres; sem, é apenas acrescentado.
+ */
+static void decompor(listas_buddy_t *b, bloco_t inicio, bloco_t fim, int fundir) {
+    while (inicio < fim) {
+        int ordem = inicio ? __builtin_ctzll(inicio) : ORDEM_MAXIMA_BUDDY;
+        if (ordem > ORDEM_MAXIMA_BUDDY) ordem = ORDEM_MAXIMA_BUDDY;
+        while (tamanho_ordem(ordem) > fim - inicio) ordem--;
+
+        if (fundir) devolver(b, inicio, ordem);
+        else adicionar(b, inicio, ordem);
+        inicio += tamanho_ordem(ordem);
+    }
+}
+
+static void descartar(listas_buddy_t *b) {
+    liberar_nos(b->raiz);
+    b->raiz = NULL;
+    for (int k = 0; k <= ORDEM_MAXIMA_BUDDY; k++) b->listas[k] = NULL;
+    b->validas = 0;
+}
+
+/// Recria as listas a partir das regiões livres maximais da memória.
+static void reconstruir(simulador_t *sim) {
+    listas_buddy_t *b = &sim->buddy;
+    descartar(b);
+    for (no_livre_t *r = indice_proximo(&sim->memoria.livres, 0); r;
+         r = indice_proximo(&sim->memoria.livres, r->inicio + 1))
+        decompor(b, r->inicio, r->inicio + r->tamanho, 0);
+    b->validas = 1;
+}
+
+/* ---------------- Interface ---------------- */
+
+int buddy_ordem(bloco_t tamanho) {
+    int ordem = 0;
+    while (ordem <= ORDEM_MAXIMA_BUDDY && tamanho_ordem(ordem) < tamanho) ordem++;
+    return ordem;
+}
+
+bloco_buddy_t *buddy_buscar(simulador_t *sim, int ordem) {
+    listas_buddy_t *b = &sim->buddy;
+    if (!b->validas) reconstruir(sim);
+
+    for (int k = ordem; k <= ORDEM_MAXIMA_BUDDY; k++) {
+        if (b->listas[k]) {
+            visitas_indice.regioes++;
+            visitas_indice.blocos += tamanho_ordem(k);
+            return b->listas[k];
+        }
+    }
+    return NULL;
+}
+
+void buddy_registrar_desperdicio(simulador_t *sim, bloco_t inicio, bloco_t desperdicio) {
+    no_ocupado_t *ext = mapa_contendo(&sim->memoria.ocupadas, inicio);
+    if (!ext) return;
+    ext->desperdicio = desperdicio;
+    sim->buddy.desperdicio += desperdicio;
+}
+
+bloco_t buddy_desperdicio(const simulador_t *sim) {
+    return sim->buddy.desperdicio;
+}
+
+void buddy_ocupacao(simulador_t *sim, bloco_t inicio, bloco_t tamanho) {
+    listas_buddy_t *b = &sim->buddy;
+    if (!b->validas) return;
+
+    bloco_t fim = inicio + tamanho;
+    bloco_t a = inicio;
+    while (a < fim) {
+        bloco_buddy_t *no = anterior_ou_igual(b, a);
+        if (!no || a >= no->inicio + tamanho_ordem(no->ordem)) {
+            // Listas fora de sincronia com o índice: reconstrói no próximo uso
+            descartar(b);
+            return;
+        }
+
+        bloco_t b_inicio = no->inicio;
+        bloco_t b_fim = b_inicio + tamanho_ordem(no->ordem);
+        retirar(b, no);
+
+        // As sobras do bloco não podem ter buddy livre: basta reinseri-las
+        if (b_inicio < inicio) decompor(b, b_inicio, inicio, 0);
+        if (fim < b_fim) decompor(b, fim, b_fim, 0);
+        a = b_fim;
+    }
+}
+
+void buddy_liberacao(simulador_t *sim, bloco_t inicio, bloco_t tamanho) {
+    if (sim->buddy.desperdicio > 0) {
+        no_ocupado_t *ext = mapa_contendo(&sim->memoria.ocupadas, inicio);
+        if (ext && ext->inicio == inicio) sim->buddy.desperdicio -= ext->desperdicio;
+    }
+    if (sim->buddy.validas) decompor(&sim->buddy, inicio, inicio + tamanho, 1);
+}
+
+void buddy_invalidar(simulador_t *sim) {
+    descartar(&sim->buddy);
+}
+
+void buddy_limpar(simulador_t *sim) {
+    descartar(&sim->buddy);
+    sim->buddy.desperdicio = 0;
+}
@@ -0,0 +1,348 @@
+/**
+ * @file comandos.c
+ * @brief Implementação do interpretador de comandos do simulador.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "../include/comandos.h"
+#include "../include/memoria.h"
+#include "../include/alocacao.h"
+#include "../include/estado_binario.h"
+#include "../include/diario.h"
+#include "../include/metricas.h"
+#include "../include/log.h"
+
+void definir_alteracoes(simulador_t *sim, int ativo) {
+    sim->sessao.alteracoes = ativo;
+}
+
+void definir_checkpoint(simulador_t *sim, long intervalo) {
+    sim->sessao.intervalo_checkpoint = intervalo;
+    sim->sessao.desde_checkpoint = 0;
+}
+
+/// Grava o estado se o intervalo de checkpoint foi atingido.
+static void verificar_checkpoint(simulador_t *sim) {
+    sessao_comandos_t *s = &sim->sessao;
+    if (s->intervalo_checkpoint <= 0) return;
+
+    if (diario_ativo(sim)) {
+        if (diario_pendentes(sim) < s->intervalo_checkpoint) return;
+        diario_checkpoint(sim);
+    } else if (++s->desde_checkpoint < s->intervalo_checkpoint) {
+        return;
+    }
+
+    s->desde_checkpoint = 0;
+    salvar_estado(sim, NULL);
+}
+
+void definir_arquivo_estado(simulador_t *sim, const char *arquivo, int binario) {
+    sim->sessao.arquivo_estado = arquivo;
+    sim->sessao.binario = binario;
+}
+
+void salvar_estado(simulador_t *sim, const char *arquivo) {
+    if (!arquivo) arquivo = sim->sessao.arquivo_estado ? sim->sessao.arquivo_estado : "estado.txt";
+
+    if (sim->sessao.binario) {
+        if (salvar_memoria_binaria(sim, arquivo) < 0)
+            fprintf(stderr, "Erro ao gravar estado binário: %s\n", arquivo);
+    } else {
+        salvar_memoria(sim, arquivo);
+    }
+}
+
+/// Responde o comando `estado`: tamanho da memória seguido das extensões ocupadas.
+static void responder_estado(const simulador_t *sim, FILE *saida) {
+    fprintf(saida, "estado %lld", sim->memoria.tamanho);
+    for (no_ocupado_t *ext = mapa_proximo(&sim->memoria.ocupadas, 0); ext;
+         ext = mapa_proximo(&sim->memoria.ocupadas, ext->inicio + 1))
+        fprintf(saida, " %lld %lld %d", ext->inicio, ext->tamanho, ext->pid);
+    fputc('\n', saida);
+}
+
+/// Responde um passo de `compactar <orçamento>`: total movido, conclusão e mapa de realocação.
+static void responder_compactacao(simulador_t *sim, FILE *saida, bloco_t orcamento) {
+    passo_compactacao_t passo;
+    compactar_passo(sim, orcamento, &passo);
+
+    fprintf(saida, "compactar %lld %d", passo.movidos, passo.concluida);
+    for (int k = 0; k < passo.quantidade; k++)
+        fprintf(saida, " %d %lld %lld %lld", passo.realocacoes[k].pid, passo.realocacoes[k].antigo,
+                passo.realocacoes[k].novo, passo.realocacoes[k].tamanho);
+    fputc('\n', saida);
+    free(passo.realocacoes);
+}
+
+int interpretar_lote(const char *linha, char *algoritmo, int *ordenar, pedido_lote_t **pedidos) {
+    char opcao[16];
+    int lidos, n;
+
+    if (sscanf(linha, "%*s %15s%n", algoritmo, &lidos) != 1 || !estrategia_por_nome(algoritmo))
+        return -1;
+    const char *c = linha + lidos;
+    *ordenar = 0;
+    if (sscanf(c, "%15s%n", opcao, &n) == 1 && strcmp(opcao, "ordenar") == 0) {
+        *ordenar = 1;
+        c += n;
+    }
+
+    // Cada pedido ocupa ao menos 4 caracteres ("1 1 "): a linha limita o lote
+    pedido_lote_t *p = malloc((strlen(c) / 4 + 1) * sizeof(pedido_lote_t));
+    int quantidade = 0;
+    while (sscanf(c, "%d %lld%n", &p[quantidade].pid, &p[quantidade].tamanho, &n) == 2) {
+        quantidade++;
+        c += n;
+    }
+    if (quantidade == 0) {
+        free(p);
+        return -1;
+    }
+    *pedidos = p;
+    return quantidade;
+}
+
+/// Executa `lote <algoritmo> [ordenar] <pid> <tamanho>...` e responde o início de cada pedido.
+static resultado_comando_t responder_lote(simulador_t *sim, const char *linha, FILE *saida, char *erro, size_t tam_erro) {
+    char algoritmo[16];
+    int ordenar;
+    pedido_lote_t *pedidos;
+
+    int quantidade = interpretar_lote(linha, algoritmo, &ordenar, &pedidos);
+    if (quantidade < 0) {
+        snprintf(erro, tam_erro, "uso: lote <algoritmo> [ordenar] <pid> <tamanho>...");
+        return COMANDO_FALHOU;
+    }
+
+    int atendidos = alocar_lote(sim, pedidos, quantidade, estrategia_por_nome(algoritmo), ordenar);
+    fprintf(saida, "lote %d", atendidos);
+    for (int k = 0; k < quantidade; k++) {
+        if (pedidos[k].inicio < 0) log_erro(pedidos[k].pid, algoritmo, "pedido do lote não atendido");
+        fprintf(saida, " %d %lld", pedidos[k].pid, pedidos[k].inicio);
+    }
+    fputc('\n', saida);
+    free(pedidos);
+    return COMANDO_ALTERADO;
+}
+
+/// Responde o comando `stats` com as estatísticas de fragmentação, em JSON (uma linha).
+static void responder_stats(const simulador_t *sim, FILE *saida) {
+    fragmentacao_t frag;
+    calcular_fragmentacao(sim, &frag);
+
+    fprintf(saida, "{\"livres\":%lld,\"regioes\":%d,\"maior\":%lld,\"menor\":%lld,"
+                   "\"indice\":%.6f,\"interna\":%lld,\"next_examinados\":%.2f,\"histograma\":[",
+            frag.livres, frag.regioes, frag.maior, frag.menor, frag.indice, frag.interna,
+            next_fit_media_examinados(sim));
+    for (int k = 0; k < frag.faixas; k++)
+        fprintf(saida, k ? ",%d" : "%d", frag.histograma[k]);
+    fputs("],\"metricas\":", saida);
+    metricas_json(&sim->metricas, saida);
+    fputs(",\"espera\":", saida);
+    espera_json(&sim->espera, saida);
+    fputs("}\n", saida);
+}
+
+resultado_comando_t executar_comando(simulador_t *sim, const char *linha, FILE *saida, char *erro, size_t tam_erro) {
+    char comando[16], algoritmo[16], arquivo[TAM_LINHA];
+    int pid;
+    bloco_t tamanho;
+    unsigned long long prazo = 0;
+
+    if (sscanf(linha, "%15s", comando) != 1 || comando[0] == '#')
+        return COMANDO_IGNORADO;
+
+    alteracoes_zerar(sim);
+    espera_avancar(sim);
+
+    if (strcmp(comando, "alocar") == 0) {
+        if (sscanf(linha, "%*s %d %lld %15s %llu", &pid, &tamanho, algoritmo, &prazo) < 3) {
+            snprintf(erro, tam_erro, "uso: alocar <pid> <tamanho> <algoritmo> [prazo]");
+            return COMANDO_FALHOU;
+        }
+
+        if (pid_existe(sim, pid)) {
+            snprintf(erro, tam_erro, "processo %d já está alocado.", pid);
+            return COMANDO_FALHOU;
+        }
+        if (espera_contem(sim, pid)) {
+            snprintf(erro, tam_erro, "processo %d já está na fila de espera.", pid);
+            return COMANDO_FALHOU;
+        }
+
+        funcao_alocacao_t estrategia = estrategia_por_nome(algoritmo);
+        int sucesso = estrategia ? estrategia(sim, pid, tamanho) : 0;
+
+        if (!sucesso && estrategia && pid > 0 && tamanho > 0 && tamanho <= sim->memoria.tamanho &&
+            espera_enfileirar(sim, pid, tamanho, estrategia, algoritmo, prazo)) {
+            log_registrar(NIVEL_LOG_INFO, pid, algoritmo, "sem espaço; pedido na fila de espera");
+            return COMANDO_ENFILEIRADO;
+        }
+
+        if (!sucesso) {
+            log_erro(pid, algoritmo, estrategia ? "memória insuficiente" : "estratégia desconhecida");
+            snprintf(erro, tam_erro, "Falha na alocação PID %d (%s fit)", pid, algoritmo);
+            return COMANDO_FALHOU;
+        }
+
+    } else if (strcmp(comando, "lote") == 0) {
+        resultado_comando_t r = responder_lote(sim, linha, saida, erro, tam_erro);
+        if (r != COMANDO_FALHOU) verificar_checkpoint(sim);
+        return r;
+
+    } else if (strcmp(comando, "liberar") == 0) {
+        if (sscanf(linha, "%*s %d", &pid) != 1) {
+            snprintf(erro, tam_erro, "uso: liberar <pid>");
+            return COMANDO_FALHOU;
+        }
+        if (espera_cancelar(sim, pid))
+            log_registrar(NIVEL_LOG_INFO, pid, "liberar", "pedido retirado da fila de espera");
+        else if (!pid_existe(sim, pid))
+            log_registrar(NIVEL_LOG_AVISO, pid, "liberar", "processo não está alocado");
+        liberar_memoria(sim, pid);
+
+    } else if (strcmp(comando, "realocar") == 0) {
+        strcpy(algoritmo, "first");
+        if (sscanf(linha, "%*s %d %lld %15s", &pid, &tamanho, algoritmo) < 2 || tamanho <= 0) {
+            snprintf(erro, tam_erro, "uso: realocar <pid> <tamanho > 0> [algoritmo]");
+            return COMANDO_FALHOU;
+        }
+        if (pid == 0 || !pid_existe(sim, pid)) {
+            snprintf(erro, tam_erro, "processo %d não está alocado.", pid);
+            return COMANDO_FALHOU;
+        }
+
+        funcao_alocacao_t estrategia = estrategia_por_nome(algoritmo);
+        bloco_t movidos = estrategia ? realocar_memoria(sim, pid, tamanho, estrategia) : -1;
+        if (movidos < 0) {
+            log_erro(pid, algoritmo, estrategia ? "memória insuficiente para realocar" : "estratégia desconhecida");
+            snprintf(erro, tam_erro, "Falha ao realocar PID %d para %lld blocos", pid, tamanho);
+            return COMANDO_FALHOU;
+        }
+        fprintf(saida, "realocar %lld\n", movidos);
+        verificar_checkpoint(sim);
+        return COMANDO_ALTERADO;
+
+    } else if (strcmp(comando, "compactar") == 0) {
+        bloco_t orcamento;
+        if (sscanf(linha, "%*s %lld", &orcamento) == 1) {
+            if (orcamento <= 0) {
+                snprintf(erro, tam_erro, "uso: compactar [orcamento > 0]");
+                return COMANDO_FALHOU;
+            }
+            responder_compactacao(sim, saida, orcamento);
+            verificar_checkpoint(sim);
+            return COMANDO_ALTERADO;
+        }
+        compactar_memoria(sim);
+
+    } else if (strcmp(comando, "snapshot") == 0) {
+        fprintf(saida, "snapshot %llu\n", instantaneo_criar(sim));
+        return COMANDO_RESPONDIDO;
+
+    } else if (strcmp(comando, "snapshots") == 0) {
+        instantaneo_listar(sim, saida);
+        return COMANDO_RESPONDIDO;
+
+    } else if (strcmp(comando, "restaurar") == 0 || strcmp(comando, "descartar") == 0) {
+        unsigned long long id;
+        if (sscanf(linha, "%*s %llu", &id) != 1) {
+            snprintf(erro, tam_erro, "uso: %s <id>", comando);
+            return COMANDO_FALHOU;
+        }
+        int restaurar = strcmp(comando, "restaurar") == 0;
+        if ((restaurar ? instantaneo_restaurar(sim, id) : instantaneo_descartar(sim, id)) < 0) {
+            snprintf(erro, tam_erro, "snapshot %llu não existe.", id);
+            return COMANDO_FALHOU;
+        }
+
+    } else if (strcmp(comando, "estado") == 0) {
+        responder_estado(sim, saida);
+        return COMANDO_RESPONDIDO;
+
+    } else if (strcmp(comando, "fila") == 0) {
+        espera_listar(sim, saida);
+        return COMANDO_RESPONDIDO;
+
+    } else if (strcmp(comando, "stats") == 0) {
+        responder_stats(sim, saida);
+        return COMANDO_RESPONDIDO;
+
+    } else if (strcmp(comando, "salvar") == 0) {
+        salvar_estado(sim, sscanf(linha, "%*s %255s", arquivo) == 1 ? arquivo : NULL);
+
+    } else if (strcmp(comando, "exportar") == 0) {
+        if (sscanf(linha, "%*s %255s", arquivo) != 1) {
+            snprintf(erro, tam_erro, "uso: exportar <arquivo>");
+            return COMANDO_FALHOU;
+        }
+        salvar_memoria(sim, arquivo);
+
+    } else if (strcmp(comando, "importar") == 0) {
+        if (sscanf(linha, "%*s %255s", arquivo) != 1) {
+            snprintf(erro, tam_erro, "uso: importar <arquivo>");
+            return COMANDO_FALHOU;
+        }
+        if (carregar_memoria(sim, arquivo) < 0) {
+            snprintf(erro, tam_erro, "não foi possível carregar %s", arquivo);
+            return COMANDO_FALHOU;
+        }
+
+    } else if (strcmp(comando, "sair") == 0) {
+        return COMANDO_SAIR;
+
+    } else if (strcmp(comando, "desligar") == 0) {
+        return COMANDO_DESLIGAR;
+
+    } else {
+        snprintf(erro, tam_erro, "comando desconhecido: %s", comando);
+        return COMANDO_FALHOU;
+    }
+
+    verificar_checkpoint(sim);
+    return COMANDO_OK;
+}
+
+/// Escreve `ok` seguido dos trechos alterados, ou `ok *` se a lista estiver incompleta.
+static void escrever_alteracoes(const alteracoes_t *a, FILE *saida) {
+    if (a->incompleta) {
+        fputs("ok *\n", saida);
+        return;
+    }
+    fputs("ok", saida);
+    for (int k = 0; k < a->quantidade; k++)
+        fprintf(saida, " %lld %lld %d", a->itens[k].inicio, a->itens[k].tamanho, a->itens[k].pid);
+    fputc('\n', saida);
+}
+
+resultado_comando_t responder_comando(simulador_t *sim, const char *linha, FILE *saida) {
+    char erro[128];
+    resultado_comando_t r = executar_comando(sim, linha, saida, erro, sizeof(erro));
+
+    switch (r) {
+    case COMANDO_FALHOU:
+        fprintf(saida, "erro %s\n", erro);
+        break;
+    case COMANDO_OK:
+        if (sim->sessao.alteracoes) {
+            escrever_alteracoes(&sim->alteracoes, saida);
+            break;
+        }
+        // fallthrough
+    case COMANDO_SAIR:
+    case COMANDO_DESLIGAR:
+        fputs("ok\n", saida);
+        break;
+    case COMANDO_ENFILEIRADO:
+        fputs("espera\n", saida);
+        break;
+    case COMANDO_ALTERADO:
+        if (sim->sessao.alteracoes) escrever_alteracoes(&sim->alteracoes, saida);
+        break;
+    default:
+        break;
+    }
+    return r;
+}
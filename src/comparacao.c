@@ -0,0 +1,215 @@
+/**
+ * @file comparacao.c
+ * @brief Implementação da reprodução paralela de traces por estratégia.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "../include/comparacao.h"
+#include "../include/comandos.h"
+#include "../include/memoria.h"
+#include "../include/alocacao.h"
+
+static void acrescentar(trace_t *trace, char tipo, int pid, bloco_t valor) {
+    if (trace->quantidade == trace->capacidade) {
+        trace->capacidade = trace->capacidade ? 2 * trace->capacidade : 1024;
+        trace->operacoes = realloc(trace->operacoes, trace->capacidade * sizeof(operacao_trace_t));
+    }
+    trace->operacoes[trace->quantidade++] = (operacao_trace_t){ tipo, pid, valor };
+}
+
+int trace_carregar(const char *arquivo, trace_t *trace) {
+    FILE *f = strcmp(arquivo, "-") == 0 ? stdin : fopen(arquivo, "r");
+    if (!f) return -1;
+
+    memset(trace, 0, sizeof(*trace));
+    char linha[TAM_LINHA], comando[16], algoritmo[16];
+    int pid, ordenar;
+    bloco_t valor;
+    pedido_lote_t *pedidos;
+
+    // Mesmas regras de executar_comando: o que ele recusaria não é reproduzido
+    while (fgets(linha, sizeof(linha), f)) {
+        if (sscanf(linha, "%15s", comando) != 1 || comando[0] == '#') continue;
+
+        if (strcmp(comando, "alocar") == 0) {
+            if (sscanf(linha, "%*s %d %lld %15s", &pid, &valor, algoritmo) == 3)
+                acrescentar(trace, 'A', pid, valor);
+            else
+                trace->invalidas++;
+        } else if (strcmp(comando, "realocar") == 0) {
+            if (sscanf(linha, "%*s %d %lld", &pid, &valor) == 2 && valor > 0)
+                acrescentar(trace, 'R', pid, valor);
+            else
+                trace->invalidas++;
+        } else if (strcmp(comando, "liberar") == 0) {
+            if (sscanf(linha, "%*s %d", &pid) == 1)
+                acrescentar(trace, 'L', pid, 0);
+            else
+                trace->invalidas++;
+        } else if (strcmp(comando, "compactar") == 0) {
+            if (sscanf(linha, "%*s %lld", &valor) != 1)
+                acrescentar(trace, 'C', 0, 0);
+            else if (valor > 0)
+                acrescentar(trace, 'C', 0, valor);
+            else
+                trace->invalidas++;
+        } else if (strcmp(comando, "lote") == 0) {
+            int quantidade = interpretar_lote(linha, algoritmo, &ordenar, &pedidos);
+            if (quantidade < 0) {
+                trace->invalidas++;
+                continue;
+            }
+            acrescentar(trace, 'B', ordenar, quantidade);
+            for (int k = 0; k < quantidade; k++)
+                acrescentar(trace, 'P', pedidos[k].pid, pedidos[k].tamanho);
+            free(pedidos);
+        }
+    }
+
+    if (f != stdin) fclose(f);
+    return 0;
+}
+
+void trace_liberar(trace_t *trace) {
+    free(trace->operacoes);
+    memset(trace, 0, sizeof(*trace));
+}
+
+/// Trabalho de uma thread: uma combinação de estratégia e tamanho.
+typedef struct {
+    const trace_t *trace;
+    funcao_alocacao_t alocar;
+    resultado_comparacao_t *resultado;
+} tarefa_comparacao_t;
+
+static double agora() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/// Reproduz o trace numa simulação própria da tarefa.
+static void *reproduzir(void *arg) {
+    tarefa_comparacao_t *tarefa = arg;
+    resultado_comparacao_t *r = tarefa->resultado;
+    simulador_t sim;
+    fragmentacao_t frag;
+    double inicio = agora();
+
+    if (simulador_criar(&sim, r->tamanho) < 0) return NULL;
+
+    // Um lote cabe numa linha de comando (ver interpretar_lote)
+    pedido_lote_t *pedidos = malloc((TAM_LINHA / 4 + 1) * sizeof(pedido_lote_t));
+
+    for (long k = 0; k < tarefa->trace->quantidade; k++) {
+        const operacao_trace_t *op = &tarefa->trace->operacoes[k];
+
+        if (op->tipo == 'A') {
+            r->alocacoes++;
+            if (pid_existe(&sim, op->pid) || !tarefa->alocar(&sim, op->pid, op->valor)) r->falhas++;
+        } else if (op->tipo == 'R') {
+            r->alocacoes++;
+            if (realocar_memoria(&sim, op->pid, op->valor, tarefa->alocar) < 0) r->falhas++;
+        } else if (op->tipo == 'B') {
+            // Os pedidos do lote vêm logo depois da operação
+            int quantidade = (int)op->valor;
+            for (int j = 0; j < quantidade; j++)
+                pedidos[j] = (pedido_lote_t){ .pid = op[j + 1].pid, .tamanho = op[j + 1].valor };
+            r->alocacoes += quantidade;
+            r->falhas += quantidade - alocar_lote(&sim, pedidos, quantidade, tarefa->alocar, op->pid);
+            k += quantidade;
+        } else if (op->tipo == 'L') {
+            liberar_memoria(&sim, op->pid);
+        } else if (op->valor > 0) {
+            passo_compactacao_t passo;
+            compactar_passo(&sim, op->valor, &passo);
+            free(passo.realocacoes);
+        } else {
+            compactar_memoria(&sim);
+        }
+
+        calcular_fragmentacao(&sim, &frag);
+        if (frag.indice > r->pico_indice) r->pico_indice = frag.indice;
+    }
+
+    calcular_fragmentacao(&sim, &frag);
+    r->livres = frag.livres;
+    r->regioes = frag.regioes;
+    r->maior = frag.maior;
+    r->interna = frag.interna;
+    r->segundos = agora() - inicio;
+
+    free(pedidos);
+    simulador_destruir(&sim);
+    return NULL;
+}
+
+/// Fila de tarefas repartida entre as threads.
+typedef struct {
+    tarefa_comparacao_t *tarefas;
+    int total;
+    int proxima;        ///< Próxima tarefa livre (incrementada atomicamente)
+} fila_comparacao_t;
+
+/// Thread de trabalho: reproduz tarefas da fila até esvaziá-la.
+static void *trabalhar(void *arg) {
+    fila_comparacao_t *fila = arg;
+    int k;
+    while ((k = __atomic_fetch_add(&fila->proxima, 1, __ATOMIC_RELAXED)) < fila->total)
+        reproduzir(&fila->tarefas[k]);
+    return NULL;
+}
+
+int comparar_estrategias(const trace_t *trace, const char *const *estrategias, int num_estrategias,
+                         const bloco_t *tamanhos, int num_tamanhos, resultado_comparacao_t *resultados) {
+    int total = num_estrategias * num_tamanhos;
+    tarefa_comparacao_t *tarefas = calloc(total, sizeof(tarefa_comparacao_t));
+
+    for (int e = 0; e < num_estrategias; e++) {
+        funcao_alocacao_t alocar = estrategia_por_nome(estrategias[e]);
+        if (!alocar) {
+            free(tarefas);
+            return -1;
+        }
+        for (int t = 0; t < num_tamanhos; t++) {
+            int k = e * num_tamanhos + t;
+            memset(&resultados[k], 0, sizeof(resultados[k]));
+            resultados[k].estrategia = estrategias[e];
+            resultados[k].tamanho = tamanhos[t];
+            tarefas[k] = (tarefa_comparacao_t){ trace, alocar, &resultados[k] };
+        }
+    }
+
+    // Cada tarefa tem sua simulação; as threads (uma por núcleo) só repartem a fila
+    long nucleos = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nucleos < 1) nucleos = 1;
+    if (nucleos > total) nucleos = total;
+    fila_comparacao_t fila = { tarefas, total, 0 };
+    pthread_t *threads = malloc(nucleos * sizeof(pthread_t));
+
+    for (long k = 0; k < nucleos; k++)
+        pthread_create(&threads[k], NULL, trabalhar, &fila);
+    for (long k = 0; k < nucleos; k++)
+        pthread_join(threads[k], NULL);
+
+    free(threads);
+    free(tarefas);
+    return 0;
+}
+
+void imprimir_comparacao(const resultado_comparacao_t *resultados, int quantidade, FILE *saida) {
+    fprintf(saida, "%-6s %10s %9s %8s %8s %8s %10s %8s %10s %9s %9s\n", "estrat", "memoria",
+            "alocacoes", "falhas", "% falha", "frag max", "livres", "regioes", "maior", "interna", "ms");
+
+    for (int k = 0; k < quantidade; k++) {
+        const resultado_comparacao_t *r = &resultados[k];
+        fprintf(saida, "%-6s %10lld %9ld %8ld %7.2f%% %8.3f %10lld %8d %10lld %9lld %9.1f\n",
+                r->estrategia, r->tamanho, r->alocacoes, r->falhas,
+                r->alocacoes ? 100.0 * r->falhas / r->alocacoes : 0.0, r->pico_indice,
+                r->livres, r->regioes, r->maior, r->interna, r->segundos * 1000);
+    }
+}
@@ -0,0 +1,173 @@
+/**
+ * @file diario.c
+ * @brief Implementação do diário de operações e de seus checkpoints.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../include/diario.h"
+#include "../include/memoria.h"
+
+int diario_recuperar(simulador_t *sim, const char *arquivo) {
+    FILE *f = fopen(arquivo, "r");
+    if (!f) return -1;
+
+    char linha[128];
+    int versao;
+    bloco_t tamanho;
+    long num_extensoes;
+
+    if (!fgets(linha, sizeof(linha), f) ||
+        sscanf(linha, "diario %d %lld %ld", &versao, &tamanho, &num_extensoes) != 3 ||
+        versao != VERSAO_DIARIO || tamanho <= 0) {
+        fclose(f);
+        return -1;
+    }
+
+    long fim_valido = ftell(f);
+    long lidas = 0;
+    sim->diario.pendentes = 0;
+    iniciar_montagem(sim, tamanho);
+    if (num_extensoes == 0) concluir_montagem(sim);
+
+    while (fgets(linha, sizeof(linha), f)) {
+        // Uma linha sem '\n' foi interrompida no meio da escrita
+        if (!strchr(linha, '\n')) break;
+
+        int pid;
+        bloco_t inicio, destino, tam;
+
+        if (lidas < num_extensoes) {
+            if (sscanf(linha, "A %d %lld %lld", &pid, &inicio, &tam) != 3) break;
+            montar_extensao(sim, inicio, tam, pid);
+            if (++lidas == num_extensoes) concluir_montagem(sim);
+        } else if (sscanf(linha, "A %d %lld %lld", &pid, &inicio, &tam) == 3) {
+            ocupar_intervalo(sim, inicio, tam, pid);
+            sim->diario.pendentes++;
+        } else if (sscanf(linha, "L %d", &pid) == 1) {
+            liberar_memoria(sim, pid);
+            sim->diario.pendentes++;
+        } else if (sscanf(linha, "M %lld %lld %lld", &inicio, &destino, &tam) == 3) {
+            mover_extensao(sim, inicio, destino, tam);
+            sim->diario.pendentes++;
+        } else if (sscanf(linha, "R %lld %lld %lld", &inicio, &destino, &tam) == 3) {
+            redimensionar_extensao(sim, inicio, destino, tam);
+            sim->diario.pendentes++;
+        } else if (linha[0] == 'C') {
+            compactar_memoria(sim);
+            sim->diario.pendentes++;
+        } else {
+            break;
+        }
+        fim_valido = ftell(f);
+    }
+
+    if (lidas < num_extensoes) concluir_montagem(sim);
+    fclose(f);
+
+    // Descarta o que houver depois da última operação completa
+    if (truncate(arquivo, fim_valido) < 0)
+        perror("Erro ao truncar diário");
+    return 0;
+}
+
+/// Grava um checkpoint da memória atual em `f`.
+static void escrever_checkpoint(const simulador_t *sim, FILE *f) {
+    fprintf(f, "diario %d %lld %d\n", VERSAO_DIARIO, sim->memoria.tamanho, sim->memoria.ocupadas.quantidade);
+    for (no_ocupado_t *ext = mapa_proximo(&sim->memoria.ocupadas, 0); ext;
+         ext = mapa_proximo(&sim->memoria.ocupadas, ext->inicio + 1))
+        fprintf(f, "A %d %lld %lld\n", ext->pid, ext->inicio, ext->tamanho);
+}
+
+void diario_checkpoint(simulador_t *sim) {
+    if (!sim->diario.arquivo) return;
+
+    char temporario[4096];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", sim->diario.caminho);
+
+    FILE *f = fopen(temporario, "w");
+    if (!f) {
+        perror("Erro ao gravar checkpoint do diário");
+        return;
+    }
+    escrever_checkpoint(sim, f);
+    fflush(f);
+    fsync(fileno(f));
+    fclose(f);
+
+    fclose(sim->diario.arquivo);
+    if (rename(temporario, sim->diario.caminho) < 0)
+        perror("Erro ao gravar checkpoint do diário");
+    sim->diario.arquivo = fopen(sim->diario.caminho, "a");
+    sim->diario.pendentes = 0;
+}
+
+int diario_abrir(simulador_t *sim, const char *arquivo, int recuperado) {
+    diario_fechar(sim);
+    sim->diario.caminho = strdup(arquivo);
+
+    sim->diario.arquivo = fopen(sim->diario.caminho, recuperado ? "a" : "w");
+    if (!sim->diario.arquivo) {
+        perror("Erro ao abrir diário");
+        return -1;
+    }
+
+    if (!recuperado) {
+        escrever_checkpoint(sim, sim->diario.arquivo);
+        fflush(sim->diario.arquivo);
+        sim->diario.pendentes = 0;
+    }
+    return 0;
+}
+
+void diario_fechar(simulador_t *sim) {
+    if (sim->diario.arquivo) fclose(sim->diario.arquivo);
+    sim->diario.arquivo = NULL;
+    free(sim->diario.caminho);
+    sim->diario.caminho = NULL;
+}
+
+int diario_ativo(const simulador_t *sim) {
+    return sim->diario.arquivo != NULL;
+}
+
+long diario_pendentes(const simulador_t *sim) {
+    return sim->diario.pendentes;
+}
+
+void diario_ocupacao(simulador_t *sim, int pid, bloco_t inicio, bloco_t tamanho) {
+    if (!sim->diario.arquivo) return;
+    fprintf(sim->diario.arquivo, "A %d %lld %lld\n", pid, inicio, tamanho);
+    fflush(sim->diario.arquivo);
+    sim->diario.pendentes++;
+}
+
+void diario_liberacao(simulador_t *sim, int pid) {
+    if (!sim->diario.arquivo) return;
+    fprintf(sim->diario.arquivo, "L %d\n", pid);
+    fflush(sim->diario.arquivo);
+    sim->diario.pendentes++;
+}
+
+void diario_compactacao(simulador_t *sim) {
+    if (!sim->diario.arquivo) return;
+    fputs("C\n", sim->diario.arquivo);
+    fflush(sim->diario.arquivo);
+    sim->diario.pendentes++;
+}
+
+void diario_movimento(simulador_t *sim, bloco_t origem, bloco_t destino, bloco_t tamanho) {
+    if (!sim->diario.arquivo) return;
+    fprintf(sim->diario.arquivo, "M %lld %lld %lld\n", origem, destino, tamanho);
+    fflush(sim->diario.arquivo);
+    sim->diario.pendentes++;
+}
+
+void diario_redimensionamento(simulador_t *sim, bloco_t origem, bloco_t destino, bloco_t tamanho) {
+    if (!sim->diario.arquivo) return;
+    fprintf(sim->diario.arquivo, "R %lld %lld %lld\n", origem, destino, tamanho);
+    fflush(sim->diario.arquivo);
+    sim->diario.pendentes++;
+}
@@ -0,0 +1,286 @@
+/**
+ * @file espera.c
+ * @brief Implementação da fila de espera de alocações.
+ *
+ * Cada pedido ocupa uma posição do vetor `pedidos` e é referenciado por dois
+ * heaps: um pela ordem de atendimento e outro pelo prazo. Pedidos atendidos,
+ * expirados ou cancelados liberam a posição na hora; as referências que
+ * sobram nos heaps são reconhecidas pelo número de chegada (`ordem`) e
+ * descartadas quando chegam ao topo, ou todas de uma vez quando passam a ser
+ * maioria. Um índice hash por PID, encadeado pelas próprias posições,
+ * responde `espera_contem` e `espera_cancelar` sem percorrer o vetor.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../include/espera.h"
+#include "../include/memoria.h"
+
+static const char *nomes_politica[] = { "desligada", "fifo", "menor" };
+
+int espera_politica_por_nome(const char *nome) {
+    for (int k = ESPERA_FIFO; k <= ESPERA_MENOR; k++)
+        if (strcmp(nome, nomes_politica[k]) == 0) return k;
+    return -1;
+}
+
+static long long agora_ns() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+/// A referência ainda aponta para o pedido que a criou?
+static int valida(const fila_espera_t *f, ref_espera_t r) {
+    return f->pedidos[r.posicao].ordem == r.ordem;
+}
+
+/// `a` deve ser atendido antes de `b`?
+static int antes_fila(const fila_espera_t *f, ref_espera_t a, ref_espera_t b) {
+    if (f->politica == ESPERA_MENOR) {
+        bloco_t ta = f->pedidos[a.posicao].tamanho, tb = f->pedidos[b.posicao].tamanho;
+        if (ta != tb) return ta < tb;
+    }
+    return a.ordem < b.ordem;
+}
+
+/// `a` vence antes de `b`?
+static int antes_prazo(const fila_espera_t *f, ref_espera_t a, ref_espera_t b) {
+    return f->pedidos[a.posicao].prazo < f->pedidos[b.posicao].prazo;
+}
+
+typedef int (*comparacao_espera_t)(const fila_espera_t *f, ref_espera_t a, ref_espera_t b);
+
+static void subir(const fila_espera_t *f, heap_espera_t *h, int k, comparacao_espera_t antes) {
+    ref_espera_t r = h->itens[k];
+    while (k > 0 && antes(f, r, h->itens[(k - 1) / 2])) {
+        h->itens[k] = h->itens[(k - 1) / 2];
+        k = (k - 1) / 2;
+    }
+    h->itens[k] = r;
+}
+
+static void descer(const fila_espera_t *f, heap_espera_t *h, int k, comparacao_espera_t antes) {
+    ref_espera_t r = h->itens[k];
+    for (;;) {
+        int filho = 2 * k + 1;
+        if (filho >= h->quantidade) break;
+        if (filho + 1 < h->quantidade && antes(f, h->itens[filho + 1], h->itens[filho])) filho++;
+        if (!antes(f, h->itens[filho], r)) break;
+        h->itens[k] = h->itens[filho];
+        k = filho;
+    }
+    h->itens[k] = r;
+}
+
+static void heap_inserir(const fila_espera_t *f, heap_espera_t *h, ref_espera_t r, comparacao_espera_t antes) {
+    if (h->quantidade == h->capacidade) {
+        h->capacidade = h->capacidade ? 2 * h->capacidade : 16;
+        h->itens = realloc(h->itens, h->capacidade * sizeof(ref_espera_t));
+    }
+    h->itens[h->quantidade++] = r;
+    subir(f, h, h->quantidade - 1, antes);
+}
+
+static void heap_retirar_topo(const fila_espera_t *f, heap_espera_t *h, comparacao_espera_t antes) {
+    h->itens[0] = h->itens[--h->quantidade];
+    if (h->quantidade > 0) descer(f, h, 0, antes);
+}
+
+/// Descarta as referências inválidas e refaz o heap (após trocar a política, por exemplo).
+static void reconstruir(const fila_espera_t *f, heap_espera_t *h, comparacao_espera_t antes) {
+    int n = 0;
+    for (int k = 0; k < h->quantidade; k++)
+        if (valida(f, h->itens[k])) h->itens[n++] = h->itens[k];
+    h->quantidade = n;
+    for (int k = n / 2 - 1; k >= 0; k--) descer(f, h, k, antes);
+}
+
+/// Primeiro pedido válido de um heap, descartando referências inválidas no topo.
+static pedido_espera_t *topo(fila_espera_t *f, heap_espera_t *h, comparacao_espera_t antes) {
+    while (h->quantidade > 0 && !valida(f, h->itens[0])) heap_retirar_topo(f, h, antes);
+    return h->quantidade > 0 ? &f->pedidos[h->itens[0].posicao] : NULL;
+}
+
+static unsigned balde_de(int pid, int num_baldes) {
+    unsigned h = (unsigned)pid * 2654435761u; // hash multiplicativo de Knuth, como em tabela_pid.c
+    return h & (unsigned)(num_baldes - 1);
+}
+
+static void indexar(fila_espera_t *f, int posicao) {
+    unsigned b = balde_de(f->pedidos[posicao].pid, f->capacidade);
+    f->pedidos[posicao].prox = f->baldes[b];
+    f->baldes[b] = posicao;
+}
+
+static void desindexar(fila_espera_t *f, int posicao) {
+    int *p = &f->baldes[balde_de(f->pedidos[posicao].pid, f->capacidade)];
+    while (*p != posicao)
+        p = &f->pedidos[*p].prox;
+    *p = f->pedidos[posicao].prox;
+}
+
+/// Tira um pedido da fila, liberando sua posição.
+static void retirar(fila_espera_t *f, pedido_espera_t *p) {
+    desindexar(f, (int)(p - f->pedidos));
+    p->ordem = 0;
+    f->livres[f->num_livres++] = (int)(p - f->pedidos);
+    f->pendentes--;
+
+    // Referências inválidas não podem dominar os heaps
+    if (f->fila.quantidade > 2 * f->pendentes + 16) reconstruir(f, &f->fila, antes_fila);
+    if (f->prazos.quantidade > 2 * f->pendentes + 16) reconstruir(f, &f->prazos, antes_prazo);
+}
+
+static pedido_espera_t *buscar(const fila_espera_t *f, int pid) {
+    if (f->pendentes == 0) return NULL;
+    int k = f->baldes[balde_de(pid, f->capacidade)];
+    while (k >= 0 && f->pedidos[k].pid != pid)
+        k = f->pedidos[k].prox;
+    return k >= 0 ? &f->pedidos[k] : NULL;
+}
+
+void espera_configurar(simulador_t *sim, politica_espera_t politica, unsigned long long prazo_padrao) {
+    fila_espera_t *f = &sim->espera;
+    f->politica = politica;
+    f->prazo_padrao = prazo_padrao;
+
+    if (politica == ESPERA_DESLIGADA) {
+        for (int k = 0; k < f->capacidade; k++)
+            if (f->pedidos[k].ordem) {
+                retirar(f, &f->pedidos[k]);
+                f->cancelados++;
+            }
+    }
+    reconstruir(f, &f->fila, antes_fila);
+}
+
+int espera_enfileirar(simulador_t *sim, int pid, bloco_t tamanho, funcao_alocacao_t alocar,
+                      const char *metodo, unsigned long long prazo) {
+    fila_espera_t *f = &sim->espera;
+    if (f->politica == ESPERA_DESLIGADA) return 0;
+
+    if (f->num_livres == 0) {
+        int antiga = f->capacidade;
+        f->capacidade = antiga ? 2 * antiga : 16;
+        f->pedidos = realloc(f->pedidos, f->capacidade * sizeof(pedido_espera_t));
+        f->livres = realloc(f->livres, f->capacidade * sizeof(int));
+        memset(f->pedidos + antiga, 0, (f->capacidade - antiga) * sizeof(pedido_espera_t));
+        for (int k = f->capacidade - 1; k >= antiga; k--) f->livres[f->num_livres++] = k;
+
+        // O número de baldes acompanha a capacidade: refaz o índice
+        f->baldes = realloc(f->baldes, f->capacidade * sizeof(int));
+        memset(f->baldes, -1, f->capacidade * sizeof(int));
+        for (int k = 0; k < antiga; k++)
+            if (f->pedidos[k].ordem) indexar(f, k);
+    }
+
+    int posicao = f->livres[--f->num_livres];
+    pedido_espera_t *p = &f->pedidos[posicao];
+    if (prazo == 0) prazo = f->prazo_padrao;
+
+    *p = (pedido_espera_t){ pid, tamanho, alocar, "", f->relogio, prazo ? f->relogio + prazo : 0,
+                            ++f->sequencia, agora_ns(), -1 };
+    snprintf(p->metodo, sizeof(p->metodo), "%s", metodo);
+    indexar(f, posicao);
+
+    ref_espera_t r = { posicao, p->ordem };
+    heap_inserir(f, &f->fila, r, antes_fila);
+    if (p->prazo) heap_inserir(f, &f->prazos, r, antes_prazo);
+
+    f->pendentes++;
+    f->enfileirados++;
+    return 1;
+}
+
+int espera_contem(const simulador_t *sim, int pid) {
+    return buscar(&sim->espera, pid) != NULL;
+}
+
+int espera_cancelar(simulador_t *sim, int pid) {
+    pedido_espera_t *p = buscar(&sim->espera, pid);
+    if (!p) return 0;
+    retirar(&sim->espera, p);
+    sim->espera.cancelados++;
+    return 1;
+}
+
+void espera_atender(simulador_t *sim) {
+    fila_espera_t *f = &sim->espera;
+    pedido_espera_t *p;
+
+    while ((p = topo(f, &f->fila, antes_fila))) {
+        // Sem uma região do tamanho pedido, nenhuma estratégia consegue atender
+        if (!indice_maior(&sim->memoria.livres, p->tamanho) || !p->alocar(sim, p->pid, p->tamanho))
+            break;
+
+        unsigned long long espera = f->relogio - p->chegada;
+        long long ns = agora_ns() - p->chegada_ns;
+        int faixa = ns > 1 ? 63 - __builtin_clzll(ns) : 0;
+        if (faixa >= FAIXAS_LATENCIA) faixa = FAIXAS_LATENCIA - 1;
+
+        f->atendidos++;
+        f->espera_total += espera;
+        if (espera > f->espera_maxima) f->espera_maxima = espera;
+        f->latencia[faixa]++;
+
+        heap_retirar_topo(f, &f->fila, antes_fila);
+        retirar(f, p);
+    }
+}
+
+void espera_avancar(simulador_t *sim) {
+    fila_espera_t *f = &sim->espera;
+    pedido_espera_t *p;
+    f->relogio++;
+
+    while ((p = topo(f, &f->prazos, antes_prazo)) && p->prazo <= f->relogio) {
+        heap_retirar_topo(f, &f->prazos, antes_prazo);
+        retirar(f, p);
+        f->expirados++;
+    }
+}
+
+void espera_destruir(fila_espera_t *fila) {
+    free(fila->pedidos);
+    free(fila->livres);
+    free(fila->baldes);
+    free(fila->fila.itens);
+    free(fila->prazos.itens);
+    memset(fila, 0, sizeof(*fila));
+}
+
+void espera_listar(const simulador_t *sim, FILE *saida) {
+    const fila_espera_t *f = &sim->espera;
+    ref_espera_t *ordem = malloc((f->pendentes ? f->pendentes : 1) * sizeof(ref_espera_t));
+    heap_espera_t copia = { ordem, 0, f->pendentes };
+
+    // Ordena uma cópia com o próprio heap: n inserções e n retiradas
+    for (int k = 0; k < f->fila.quantidade; k++)
+        if (valida(f, f->fila.itens[k])) heap_inserir(f, &copia, f->fila.itens[k], antes_fila);
+
+    fprintf(saida, "fila %d", f->pendentes);
+    while (copia.quantidade > 0) {
+        const pedido_espera_t *p = &f->pedidos[copia.itens[0].posicao];
+        fprintf(saida, " %d %lld %s %llu", p->pid, p->tamanho, p->metodo, f->relogio - p->chegada);
+        heap_retirar_topo(f, &copia, antes_fila);
+    }
+    fputc('\n', saida);
+    free(copia.itens);
+}
+
+void espera_json(const fila_espera_t *fila, FILE *saida) {
+    int faixas = FAIXAS_LATENCIA;
+    while (faixas > 0 && fila->latencia[faixas - 1] == 0) faixas--;
+
+    fprintf(saida, "{\"politica\":\"%s\",\"pendentes\":%d,\"enfileirados\":%ld,\"atendidos\":%ld,"
+                   "\"expirados\":%ld,\"cancelados\":%ld,\"espera_media\":%.2f,\"espera_maxima\":%llu,"
+                   "\"latencia_ns\":[",
+            nomes_politica[fila->politica], fila->pendentes, fila->enfileirados, fila->atendidos,
+            fila->expirados, fila->cancelados,
+            fila->atendidos ? (double)fila->espera_total / fila->atendidos : 0.0, fila->espera_maxima);
+    for (int k = 0; k < faixas; k++)
+        fprintf(saida, k ? ",%ld" : "%ld", fila->latencia[k]);
+    fputs("]}", saida);
+}
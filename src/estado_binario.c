@@ -0,0 +1,151 @@
+/**
+ * @file estado_binario.c
+ * @brief Leitura e gravação do estado da memória no formato binário.
+ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../include/estado_binario.h"
+#include "../include/memoria.h"
+
+/// Soma FNV-1a de 64 bits, encadeável a partir de `soma`.
+static uint64_t fnv1a(uint64_t soma, const void *dados, size_t n) {
+    const unsigned char *p = dados;
+    for (size_t i = 0; i < n; i++) {
+        soma ^= p[i];
+        soma *= 1099511628211ull;
+    }
+    return soma;
+}
+
+/// Soma de verificação do cabeçalho (com `soma` zerada) e dos registros.
+static uint64_t calcular_soma(const cabecalho_estado_t *cab, const registro_estado_t *regs) {
+    cabecalho_estado_t copia = *cab;
+    copia.soma = 0;
+
+    uint64_t soma = fnv1a(14695981039346656037ull, &copia, sizeof(copia));
+    return fnv1a(soma, regs, cab->num_extensoes * sizeof(registro_estado_t));
+}
+
+/**
+ * @brief Os registros descrevem extensões aceitas por `montar_extensao`?
+ *
+ * Em ordem, sem sobreposição e dentro da memória; as contas são feitas sem
+ * estouro, pois os campos vêm do arquivo.
+ */
+static int registros_validos(const cabecalho_estado_t *cab, const registro_estado_t *regs) {
+    int64_t fim = 0;
+    for (uint64_t i = 0; i < cab->num_extensoes; i++) {
+        const registro_estado_t *r = &regs[i];
+        if (r->pid == 0 || r->tamanho <= 0 || r->inicio < fim ||
+            (uint64_t)r->inicio > cab->tamanho || (uint64_t)r->tamanho > cab->tamanho - (uint64_t)r->inicio)
+            return 0;
+        fim = r->inicio + r->tamanho;
+    }
+    return 1;
+}
+
+int arquivo_binario(const char *arquivo) {
+    char magica[sizeof(MAGICA_ESTADO)];
+    FILE *f = fopen(arquivo, "rb");
+    if (!f) return 0;
+
+    size_t lidos = fread(magica, 1, sizeof(magica), f);
+    fclose(f);
+    return lidos == sizeof(magica) && memcmp(magica, MAGICA_ESTADO, sizeof(magica)) == 0;
+}
+
+int carregar_memoria_binaria(simulador_t *sim, const char *arquivo) {
+    int fd = open(arquivo, O_RDONLY);
+    if (fd < 0) return -1;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(cabecalho_estado_t)) {
+        close(fd);
+        return -1;
+    }
+
+    void *mapa = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) return -1;
+
+    const cabecalho_estado_t *cab = mapa;
+    const registro_estado_t *regs = (const registro_estado_t *)(cab + 1);
+    int valido = memcmp(cab->magica, MAGICA_ESTADO, sizeof(MAGICA_ESTADO)) == 0 &&
+                 cab->versao == VERSAO_ESTADO &&
+                 cab->tam_registro == sizeof(registro_estado_t) &&
+                 cab->tamanho > 0 && cab->tamanho <= INT64_MAX &&
+                 cab->num_extensoes <= (st.st_size - sizeof(*cab)) / sizeof(registro_estado_t) &&
+                 (size_t)st.st_size == sizeof(*cab) + cab->num_extensoes * sizeof(registro_estado_t) &&
+                 calcular_soma(cab, regs) == cab->soma &&
+                 registros_validos(cab, regs); // uma soma correta não garante registros coerentes
+
+    if (valido) {
+        iniciar_montagem(sim, (bloco_t)cab->tamanho);
+        for (uint64_t i = 0; i < cab->num_extensoes; i++)
+            montar_extensao(sim, regs[i].inicio, regs[i].tamanho, regs[i].pid);
+        concluir_montagem(sim);
+        sim->geracao = cab->geracao;
+    }
+
+    munmap(mapa, st.st_size);
+    return valido ? 0 : -1;
+}
+
+int salvar_memoria_binaria(simulador_t *sim, const char *arquivo) {
+    char temporario[4096];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", arquivo);
+
+    size_t n = sim->memoria.ocupadas.quantidade;
+    size_t tamanho_arquivo = sizeof(cabecalho_estado_t) + n * sizeof(registro_estado_t);
+
+    int fd = open(temporario, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return -1;
+    if (ftruncate(fd, tamanho_arquivo) < 0) {
+        close(fd);
+        unlink(temporario);
+        return -1;
+    }
+
+    void *mapa = mmap(NULL, tamanho_arquivo, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapa == MAP_FAILED) {
+        close(fd);
+        unlink(temporario);
+        return -1;
+    }
+
+    cabecalho_estado_t *cab = mapa;
+    registro_estado_t *regs = (registro_estado_t *)(cab + 1);
+
+    memset(cab, 0, sizeof(*cab));
+    memcpy(cab->magica, MAGICA_ESTADO, sizeof(MAGICA_ESTADO));
+    cab->versao = VERSAO_ESTADO;
+    cab->tam_registro = sizeof(registro_estado_t);
+    cab->tamanho = sim->memoria.tamanho;
+    cab->geracao = ++sim->geracao;
+    cab->num_extensoes = n;
+
+    size_t i = 0;
+    for (no_ocupado_t *ext = mapa_proximo(&sim->memoria.ocupadas, 0); ext;
+         ext = mapa_proximo(&sim->memoria.ocupadas, ext->inicio + 1), i++) {
+        regs[i].inicio = ext->inicio;
+        regs[i].tamanho = ext->tamanho;
+        regs[i].pid = ext->pid;
+        regs[i].reservado = 0;
+    }
+    cab->soma = calcular_soma(cab, regs);
+
+    int status = msync(mapa, tamanho_arquivo, MS_SYNC);
+    munmap(mapa, tamanho_arquivo);
+    close(fd);
+
+    if (status < 0 || rename(temporario, arquivo) < 0) {
+        unlink(temporario);
+        return -1;
+    }
+    return 0;
+}
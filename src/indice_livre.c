@@ -0,0 +1,443 @@
+/**
+ * @file indice_livre.c
+ * @brief Implementação do índice de regiões livres baseado em treaps.
+ *
+ * Os nós são compartilhados entre a árvore por endereço e a árvore por
+ * tamanho. Como as prioridades são aleatórias e independentes das chaves,
+ * ambas as árvores ficam balanceadas em média, com altura O(log R).
+ */
+
+#include <stdlib.h>
+#include "../include/indice_livre.h"
+
+/// Estado do gerador pseudoaleatório das prioridades (xorshift32), um por thread
+static _Thread_local unsigned semente = 2463534242u;
+
+_Thread_local visitas_indice_t visitas_indice;
+
+/// Conta uma região visitada por uma busca.
+static inline void visitar(const no_livre_t *no) {
+    visitas_indice.regioes++;
+    visitas_indice.blocos += no->tamanho;
+}
+
+static unsigned proxima_prioridade() {
+    semente ^= semente << 13;
+    semente ^= semente >> 17;
+    semente ^= semente << 5;
+    return semente;
+}
+
+/* ---------- Árvore por endereço (aumentada com o maior tamanho) ---------- */
+
+static bloco_t maior_de(const no_livre_t *no) {
+    return no ? no->maior : 0;
+}
+
+static void atualizar(no_livre_t *no) {
+    bloco_t m = no->tamanho;
+    if (maior_de(no->esq) > m) m = maior_de(no->esq);
+    if (maior_de(no->dir) > m) m = maior_de(no->dir);
+    no->maior = m;
+}
+
+/// Divide `t` em nós com início < chave (esq) e início >= chave (dir).
+static void dividir_endereco(no_livre_t *t, bloco_t chave, no_livre_t **esq, no_livre_t **dir) {
+    if (!t) {
+        *esq = *dir = NULL;
+    } else if (t->inicio < chave) {
+        dividir_endereco(t->dir, chave, &t->dir, dir);
+        atualizar(t);
+        *esq = t;
+    } else {
+        dividir_endereco(t->esq, chave, esq, &t->esq);
+        atualizar(t);
+        *dir = t;
+    }
+}
+
+/// Junta duas árvores onde todas as chaves de `a` são menores que as de `b`.
+static no_livre_t *juntar_endereco(no_livre_t *a, no_livre_t *b) {
+    if (!a) return b;
+    if (!b) return a;
+    if (a->prioridade > b->prioridade) {
+        a->dir = juntar_endereco(a->dir, b);
+        atualizar(a);
+        return a;
+    }
+    b->esq = juntar_endereco(a, b->esq);
+    atualizar(b);
+    return b;
+}
+
+static no_livre_t *inserir_endereco(no_livre_t *t, no_livre_t *no) {
+    if (!t) {
+        atualizar(no);
+        return no;
+    }
+    if (no->prioridade > t->prioridade) {
+        dividir_endereco(t, no->inicio, &no->esq, &no->dir);
+        atualizar(no);
+        return no;
+    }
+    if (no->inicio < t->inicio)
+        t->esq = inserir_endereco(t->esq, no);
+    else
+        t->dir = inserir_endereco(t->dir, no);
+    atualizar(t);
+    return t;
+}
+
+static no_livre_t *remover_endereco(no_livre_t *t, bloco_t inicio) {
+    if (!t) return NULL;
+    if (t->inicio == inicio)
+        return juntar_endereco(t->esq, t->dir);
+    if (inicio < t->inicio)
+        t->esq = remover_endereco(t->esq, inicio);
+    else
+        t->dir = remover_endereco(t->dir, inicio);
+    atualizar(t);
+    return t;
+}
+
+/* ---------------- Árvore por (tamanho, início) ---------------- */
+
+static int antes_por_tamanho(const no_livre_t *a, const no_livre_t *b) {
+    if (a->tamanho != b->tamanho) return a->tamanho < b->tamanho;
+    return a->inicio < b->inicio;
+}
+
+static void dividir_tamanho(no_livre_t *t, const no_livre_t *chave, no_livre_t **esq, no_livre_t **dir) {
+    if (!t) {
+        *esq = *dir = NULL;
+    } else if (antes_por_tamanho(t, chave)) {
+        dividir_tamanho(t->dir_tam, chave, &t->dir_tam, dir);
+        *esq = t;
+    } else {
+        dividir_tamanho(t->esq_tam, chave, esq, &t->esq_tam);
+        *dir = t;
+    }
+}
+
+static no_livre_t *juntar_tamanho(no_livre_t *a, no_livre_t *b) {
+    if (!a) return b;
+    if (!b) return a;
+    if (a->prioridade > b->prioridade) {
+        a->dir_tam = juntar_tamanho(a->dir_tam, b);
+        return a;
+    }
+    b->esq_tam = juntar_tamanho(a, b->esq_tam);
+    return b;
+}
+
+static no_livre_t *inserir_tamanho(no_livre_t *t, no_livre_t *no) {
+    if (!t) return no;
+    if (no->prioridade > t->prioridade) {
+        dividir_tamanho(t, no, &no->esq_tam, &no->dir_tam);
+        return no;
+    }
+    if (antes_por_tamanho(no, t))
+        t->esq_tam = inserir_tamanho(t->esq_tam, no);
+    else
+        t->dir_tam = inserir_tamanho(t->dir_tam, no);
+    return t;
+}
+
+static no_livre_t *remover_tamanho(no_livre_t *t, const no_livre_t *no) {
+    if (!t) return NULL;
+    if (t == no)
+        return juntar_tamanho(t->esq_tam, t->dir_tam);
+    if (antes_por_tamanho(no, t))
+        t->esq_tam = remover_tamanho(t->esq_tam, no);
+    else
+        t->dir_tam = remover_tamanho(t->dir_tam, no);
+    return t;
+}
+
+/* ---------------- Listas segregadas das regiões pequenas ---------------- */
+
+static void inserir_classe(indice_livre_t *indice, no_livre_t *no) {
+    if (no->tamanho > CLASSES_PEQUENAS) return;
+
+    int c = (int)no->tamanho - 1;
+    no->ant_classe = NULL;
+    no->prox_classe = indice->classes[c];
+    if (indice->classes[c]) indice->classes[c]->ant_classe = no;
+    indice->classes[c] = no;
+    indice->classes_ocupadas |= 1ULL << c;
+}
+
+static void remover_classe(indice_livre_t *indice, no_livre_t *no) {
+    if (no->tamanho > CLASSES_PEQUENAS) return;
+
+    int c = (int)no->tamanho - 1;
+    if (no->ant_classe) no->ant_classe->prox_classe = no->prox_classe;
+    else indice->classes[c] = no->prox_classe;
+    if (no->prox_classe) no->prox_classe->ant_classe = no->ant_classe;
+    if (!indice->classes[c]) indice->classes_ocupadas &= ~(1ULL << c);
+}
+
+/* ---------------- Estatísticas mantidas incrementalmente ---------------- */
+
+static int faixa_de(bloco_t tamanho) {
+    return 63 - __builtin_clzll((unsigned long long)tamanho);
+}
+
+/// Chamada depois de o nó entrar nas árvores.
+static void contar_insercao(indice_livre_t *indice, const no_livre_t *no) {
+    indice->total += no->tamanho;
+    indice->histograma[faixa_de(no->tamanho)]++;
+    if (indice->quantidade == 0 || no->tamanho < indice->menor)
+        indice->menor = no->tamanho;
+}
+
+/// Chamada depois de o nó sair das árvores e da lista segregada.
+static void contar_remocao(indice_livre_t *indice, const no_livre_t *no) {
+    indice->total -= no->tamanho;
+    indice->histograma[faixa_de(no->tamanho)]--;
+    if (no->tamanho != indice->menor) return;
+
+    // A menor região pode ter saído: a nova é a primeira da árvore por tamanho
+    if (indice->classes_ocupadas) {
+        indice->menor = __builtin_ctzll(indice->classes_ocupadas) + 1;
+    } else {
+        no_livre_t *t = indice->por_tamanho;
+        while (t && t->esq_tam) t = t->esq_tam;
+        indice->menor = t ? t->tamanho : 0;
+    }
+}
+
+/* ---------------- Operações sobre as duas árvores ---------------- */
+
+static void inserir_regiao(indice_livre_t *indice, bloco_t inicio, bloco_t tamanho) {
+    no_livre_t *no = malloc(sizeof(no_livre_t));
+    no->inicio = inicio;
+    no->tamanho = tamanho;
+    no->prioridade = proxima_prioridade();
+    no->esq = no->dir = no->esq_tam = no->dir_tam = NULL;
+
+    indice->por_endereco = inserir_endereco(indice->por_endereco, no);
+    indice->por_tamanho = inserir_tamanho(indice->por_tamanho, no);
+    inserir_classe(indice, no);
+    contar_insercao(indice, no);
+    indice->quantidade++;
+}
+
+/// Retira o nó das duas árvores sem liberá-lo.
+static void desligar_regiao(indice_livre_t *indice, no_livre_t *no) {
+    indice->por_endereco = remover_endereco(indice->por_endereco, no->inicio);
+    indice->por_tamanho = remover_tamanho(indice->por_tamanho, no);
+    remover_classe(indice, no);
+    contar_remocao(indice, no);
+    no->esq = no->dir = no->esq_tam = no->dir_tam = NULL;
+    indice->quantidade--;
+}
+
+static void liberar_nos(no_livre_t *no) {
+    if (!no) return;
+    liberar_nos(no->esq);
+    liberar_nos(no->dir);
+    free(no);
+}
+
+void indice_limpar(indice_livre_t *indice) {
+    liberar_nos(indice->por_endereco);
+    indice->por_endereco = NULL;
+    indice->por_tamanho = NULL;
+    indice->quantidade = 0;
+    for (int c = 0; c < CLASSES_PEQUENAS; c++) indice->classes[c] = NULL;
+    indice->classes_ocupadas = 0;
+    indice->total = 0;
+    indice->menor = 0;
+    for (int k = 0; k < FAIXAS_HISTOGRAMA; k++) indice->histograma[k] = 0;
+}
+
+no_livre_t *indice_proximo(const indice_livre_t *indice, bloco_t endereco) {
+    no_livre_t *t = indice->por_endereco;
+    no_livre_t *candidato = NULL;
+
+    while (t) {
+        if (t->inicio >= endereco) {
+            candidato = t;
+            t = t->esq;
+        } else {
+            t = t->dir;
+        }
+    }
+    return candidato;
+}
+
+no_livre_t *indice_primeiro(const indice_livre_t *indice, bloco_t tamanho) {
+    no_livre_t *t = indice->por_endereco;
+    if (maior_de(t) < tamanho) return NULL;
+
+    // Desce sempre pelo lado mais à esquerda que ainda comporta o pedido
+    while (t) {
+        visitar(t);
+        if (maior_de(t->esq) >= tamanho)
+            t = t->esq;
+        else if (t->tamanho >= tamanho)
+            return t;
+        else
+            t = t->dir;
+    }
+    return NULL;
+}
+
+static no_livre_t *primeiro_apos(no_livre_t *t, bloco_t endereco, bloco_t tamanho, long *examinados) {
+    while (t && t->maior >= tamanho) {
+        (*examinados)++;
+        visitar(t);
+        if (t->inicio < endereco) {
+            t = t->dir;
+            continue;
+        }
+        // Todo o lado esquerdo pode estar antes de `endereco`: tenta-o primeiro
+        no_livre_t *r = primeiro_apos(t->esq, endereco, tamanho, examinados);
+        if (r) return r;
+        if (t->tamanho >= tamanho) return t;
+        t = t->dir;
+    }
+    return NULL;
+}
+
+no_livre_t *indice_primeiro_apos(const indice_livre_t *indice, bloco_t endereco, bloco_t tamanho,
+                                 long *examinados) {
+    long visitados = 0;
+    no_livre_t *r = primeiro_apos(indice->por_endereco, endereco, tamanho, &visitados);
+    if (examinados) *examinados += visitados;
+    return r;
+}
+
+no_livre_t *indice_melhor(const indice_livre_t *indice, bloco_t tamanho) {
+    no_livre_t *t = indice->por_tamanho;
+    no_livre_t *candidato = NULL;
+
+    // Limite inferior: primeiro nó (na ordem por tamanho) que comporta o pedido
+    while (t) {
+        visitar(t);
+        if (t->tamanho >= tamanho) {
+            candidato = t;
+            t = t->esq_tam;
+        } else {
+            t = t->dir_tam;
+        }
+    }
+    return candidato;
+}
+
+no_livre_t *indice_maior(const indice_livre_t *indice, bloco_t tamanho) {
+    no_livre_t *t = indice->por_endereco;
+    if (!t || t->maior < tamanho) return NULL;
+
+    // Localiza a região de menor endereço entre as de tamanho máximo
+    bloco_t alvo = t->maior;
+    while (t) {
+        visitar(t);
+        if (maior_de(t->esq) == alvo)
+            t = t->esq;
+        else if (t->tamanho == alvo)
+            return t;
+        else
+            t = t->dir;
+    }
+    return NULL;
+}
+
+no_livre_t *indice_segregado(const indice_livre_t *indice, bloco_t tamanho) {
+    if (tamanho > CLASSES_PEQUENAS) return NULL;
+    if (tamanho < 1) tamanho = 1;
+
+    // Classes com tamanho >= pedido que não estão vazias; a menor é o bit mais baixo
+    unsigned long long candidatas = indice->classes_ocupadas & (~0ULL << (tamanho - 1));
+    if (!candidatas) return NULL;
+
+    no_livre_t *regiao = indice->classes[__builtin_ctzll(candidatas)];
+    visitar(regiao);
+    return regiao;
+}
+
+void indice_ocupar(indice_livre_t *indice, no_livre_t *regiao, bloco_t tamanho) {
+    desligar_regiao(indice, regiao);
+
+    if (regiao->tamanho > tamanho) {
+        // Reaproveita o nó para a sobra no fim da região
+        regiao->inicio += tamanho;
+        regiao->tamanho -= tamanho;
+        indice->por_endereco = inserir_endereco(indice->por_endereco, regiao);
+        indice->por_tamanho = inserir_tamanho(indice->por_tamanho, regiao);
+        inserir_classe(indice, regiao);
+        contar_insercao(indice, regiao);
+        indice->quantidade++;
+    } else {
+        free(regiao);
+    }
+}
+
+no_livre_t *indice_contendo(const indice_livre_t *indice, bloco_t endereco) {
+    no_livre_t *t = indice->por_endereco;
+    no_livre_t *candidato = NULL;
+
+    // Última região que começa em `endereco` ou antes
+    while (t) {
+        if (t->inicio <= endereco) {
+            candidato = t;
+            t = t->dir;
+        } else {
+            t = t->esq;
+        }
+    }
+
+    if (candidato && endereco < candidato->inicio + candidato->tamanho)
+        return candidato;
+    return NULL;
+}
+
+int indice_reservar(indice_livre_t *indice, bloco_t inicio, bloco_t tamanho) {
+    if (tamanho <= 0) return 0;
+
+    no_livre_t *regiao = indice_contendo(indice, inicio);
+    if (!regiao || inicio + tamanho > regiao->inicio + regiao->tamanho)
+        return 0;
+
+    bloco_t antes = inicio - regiao->inicio;
+    bloco_t depois = regiao->inicio + regiao->tamanho - (inicio + tamanho);
+    bloco_t inicio_regiao = regiao->inicio;
+
+    desligar_regiao(indice, regiao);
+    free(regiao);
+
+    if (antes > 0) inserir_regiao(indice, inicio_regiao, antes);
+    if (depois > 0) inserir_regiao(indice, inicio + tamanho, depois);
+    return 1;
+}
+
+void indice_liberar(indice_livre_t *indice, bloco_t inicio, bloco_t tamanho) {
+    no_livre_t *anterior = NULL, *seguinte = NULL;
+
+    // Procura a região que termina em `inicio` e a que começa logo após o intervalo
+    no_livre_t *t = indice->por_endereco;
+    while (t) {
+        if (t->inicio < inicio) {
+            anterior = t;
+            t = t->dir;
+        } else {
+            if (t->inicio == inicio + tamanho) seguinte = t;
+            t = t->esq;
+        }
+    }
+
+    if (anterior && anterior->inicio + anterior->tamanho == inicio) {
+        desligar_regiao(indice, anterior);
+        inicio = anterior->inicio;
+        tamanho += anterior->tamanho;
+        free(anterior);
+    }
+    if (seguinte) {
+        desligar_regiao(indice, seguinte);
+        tamanho += seguinte->tamanho;
+        free(seguinte);
+    }
+
+    inserir_regiao(indice, inicio, tamanho);
+}
@@ -0,0 +1,129 @@
+/**
+ * @file instantaneo.c
+ * @brief Implementação dos instantâneos por registro de desfazer.
+ *
+ * As anotações são desfeitas diretamente sobre o índice de regiões livres,
+ * o mapa de ocupação e a tabela de processos, sem passar pelas funções de
+ * `memoria.c`: assim a restauração não é anotada de novo nem gravada no
+ * diário operação por operação.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "../include/instantaneo.h"
+#include "../include/memoria.h"
+
+void instantaneo_anotar(simulador_t *sim, tipo_desfazer_t tipo, bloco_t inicio, bloco_t tamanho,
+                        int pid, bloco_t desperdicio) {
+    instantaneos_t *in = &sim->instantaneos;
+    if (in->num_marcas == 0) return;
+
+    if (in->quantidade == in->capacidade) {
+        in->capacidade = in->capacidade ? 2 * in->capacidade : 256;
+        in->anotacoes = realloc(in->anotacoes, in->capacidade * sizeof(anotacao_desfazer_t));
+    }
+    in->anotacoes[in->quantidade++] = (anotacao_desfazer_t){ tipo, pid, inicio, tamanho, desperdicio };
+}
+
+unsigned long long instantaneo_criar(simulador_t *sim) {
+    instantaneos_t *in = &sim->instantaneos;
+    if (in->num_marcas == in->cap_marcas) {
+        in->cap_marcas = in->cap_marcas ? 2 * in->cap_marcas : 8;
+        in->marcas = realloc(in->marcas, in->cap_marcas * sizeof(marca_instantaneo_t));
+    }
+    in->marcas[in->num_marcas++] = (marca_instantaneo_t){ ++in->ultimo_id, in->quantidade, sim->next };
+    return in->ultimo_id;
+}
+
+/// Posição do instantâneo `id` em `marcas`, ou -1.
+static int buscar_marca(const instantaneos_t *in, unsigned long long id) {
+    // Os identificadores crescem com a posição: busca binária
+    int a = 0, b = in->num_marcas - 1;
+    while (a <= b) {
+        int m = (a + b) / 2;
+        if (in->marcas[m].id == id) return m;
+        if (in->marcas[m].id < id) a = m + 1;
+        else b = m - 1;
+    }
+    return -1;
+}
+
+/// Desfaz uma anotação; o estado volta a ser o de antes dela.
+static void desfazer(simulador_t *sim, const anotacao_desfazer_t *a) {
+    memoria_t *m = &sim->memoria;
+
+    switch (a->tipo) {
+    case DESFAZER_ENTRADA: {
+        no_ocupado_t *ext = mapa_proximo(&m->ocupadas, a->inicio);
+        bloco_t tamanho = ext->tamanho;
+        sim->buddy.desperdicio -= ext->desperdicio;
+        tabela_remover_extensao(&m->processos, ext->pid, a->inicio);
+        mapa_remover(&m->ocupadas, a->inicio);
+        indice_liberar(&m->livres, a->inicio, tamanho);
+        break;
+    }
+    case DESFAZER_SAIDA:
+        indice_reservar(&m->livres, a->inicio, a->tamanho);
+        mapa_inserir(&m->ocupadas, a->inicio, a->tamanho, a->pid);
+        tabela_adicionar(&m->processos, a->pid, a->inicio, a->tamanho);
+        mapa_contendo(&m->ocupadas, a->inicio)->desperdicio = a->desperdicio;
+        sim->buddy.desperdicio += a->desperdicio;
+        break;
+    case DESFAZER_TAMANHO:
+        // Neste ponto a memória está vazia: só o tamanho e a região livre mudam
+        indice_limpar(&m->livres);
+        m->tamanho = a->tamanho;
+        if (m->tamanho > 0) indice_liberar(&m->livres, 0, m->tamanho);
+        break;
+    }
+}
+
+long instantaneo_restaurar(simulador_t *sim, unsigned long long id) {
+    instantaneos_t *in = &sim->instantaneos;
+    int k = buscar_marca(in, id);
+    if (k < 0) return -1;
+
+    long desfeitas = in->quantidade - in->marcas[k].posicao;
+    while (in->quantidade > in->marcas[k].posicao)
+        desfazer(sim, &in->anotacoes[--in->quantidade]);
+
+    in->num_marcas = k + 1;
+    sim->next = in->marcas[k].next;
+    sim->alteracoes.incompleta = 1;
+    buddy_invalidar(sim);
+    diario_checkpoint(sim);
+    espera_atender(sim);
+    return desfeitas;
+}
+
+int instantaneo_descartar(simulador_t *sim, unsigned long long id) {
+    instantaneos_t *in = &sim->instantaneos;
+    int k = buscar_marca(in, id);
+    if (k < 0) return -1;
+
+    memmove(in->marcas + k, in->marcas + k + 1, (in->num_marcas - k - 1) * sizeof(marca_instantaneo_t));
+    in->num_marcas--;
+
+    // Anotações anteriores ao instantâneo mais antigo não servem a mais ninguém
+    long inicio = in->num_marcas ? in->marcas[0].posicao : in->quantidade;
+    if (inicio > 0) {
+        memmove(in->anotacoes, in->anotacoes + inicio, (in->quantidade - inicio) * sizeof(anotacao_desfazer_t));
+        in->quantidade -= inicio;
+        for (int j = 0; j < in->num_marcas; j++) in->marcas[j].posicao -= inicio;
+    }
+    return 0;
+}
+
+void instantaneo_listar(const simulador_t *sim, FILE *saida) {
+    const instantaneos_t *in = &sim->instantaneos;
+    fprintf(saida, "snapshots %d", in->num_marcas);
+    for (int k = 0; k < in->num_marcas; k++)
+        fprintf(saida, " %llu %ld", in->marcas[k].id, in->quantidade - in->marcas[k].posicao);
+    fputc('\n', saida);
+}
+
+void instantaneo_destruir(instantaneos_t *instantaneos) {
+    free(instantaneos->anotacoes);
+    free(instantaneos->marcas);
+    memset(instantaneos, 0, sizeof(*instantaneos));
+}
@@ -1,27 +1,205 @@
+/**
+ * @file log.c
+ * @brief Implementação do log assíncrono com anel em memória.
+ *
+ * Os contadores `inicio` e `fim` só crescem; o registro `k` fica na posição
+ * `k % CAPACIDADE_LOG`. Quem registra escreve nas posições a partir de `fim`,
+ * e a thread de fundo lê as posições de `inicio` a `fim` sem a trava, pois
+ * elas só são reutilizadas depois que `inicio` avança.
+ */
+
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <time.h>
+#include <errno.h>
+#include <pthread.h>
 #include "../include/log.h"
 
-/**
- * @brief Registra uma mensagem de erro de alocação em um arquivo de log.
- *
- * @param pid ID do processo que falhou.
- * @param metodo Nome do algoritmo de alocação (ex: "First Fit").
- * @param motivo Texto explicando a falha (ex: "memória insuficiente").
- */
-void log_erro(int pid, const char *metodo, const char *motivo) {
-    FILE *f = fopen("log.txt", "a");
-    if (f == NULL) return;
+/// Registro guardado no anel até ser gravado.
+typedef struct {
+    time_t instante;
+    nivel_log_t nivel;
+    int pid;
+    char metodo[32];
+    char motivo[96];
+} registro_log_t;
+
+static const char *nomes_nivel[] = { "DEPURACAO", "INFO", "AVISO", "ERRO" };
+
+static pthread_mutex_t trava = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t ha_registros = PTHREAD_COND_INITIALIZER; ///< Acorda a thread de fundo
+static pthread_cond_t ha_espaco = PTHREAD_COND_INITIALIZER;    ///< Sinalizado após cada gravação
+
+static registro_log_t anel[CAPACIDADE_LOG];
+static unsigned long inicio = 0, fim = 0;
 
-    time_t t = time(NULL);
-    struct tm *tm_info = localtime(&t);
+static pthread_t escritor;
+static int ativo = 0;       ///< Thread de fundo em execução
+static int encerrando = 0;  ///< Pedido de término para a thread de fundo
+static int urgente = 0;     ///< Pedido de gravação imediata (`log_descarregar`)
 
-    char data[26];
-    strftime(data, 26, "%Y-%m-%d %H:%M:%S", tm_info);
+static char caminho_log[4096] = "log.txt";
+static int habilitado = 1;
+static nivel_log_t nivel_minimo = NIVEL_LOG_INFO;
+static int eco_terminal = 1;
+static FILE *arquivo = NULL;
 
-    fprintf(f, "[%s] ERRO: Processo %d | %s | Motivo: %s\n", data, pid, metodo, motivo);
-    fclose(f);
+/// Formata `instante`, reaproveitando o texto enquanto o segundo não muda.
+static const char *formatar_data(time_t instante) {
+    static time_t segundo = (time_t)-1;
+    static char data[26];
+
+    if (instante != segundo) {
+        struct tm tm_info;
+        localtime_r(&instante, &tm_info);
+        strftime(data, sizeof(data), "%Y-%m-%d %H:%M:%S", &tm_info);
+        segundo = instante;
+    }
+    return data;
+}
+
+static void gravar(const registro_log_t *r) {
+    const char *data = formatar_data(r->instante);
+    if (arquivo)
+        fprintf(arquivo, "[%s] %s: Processo %d | %s | Motivo: %s\n", data, nomes_nivel[r->nivel],
+                r->pid, r->metodo, r->motivo);
+    if (eco_terminal)
+        printf("[%s] Processo %d | %s | %s\n", nomes_nivel[r->nivel], r->pid, r->metodo, r->motivo);
+}
+
+/// Thread de fundo: grava os registros em lotes.
+static void *escrever(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&trava);
+
+    for (;;) {
+        while (!encerrando && !urgente && fim - inicio < CAPACIDADE_LOG / 2) {
+            struct timespec limite;
+            clock_gettime(CLOCK_REALTIME, &limite);
+            limite.tv_nsec += INTERVALO_LOG_MS * 1000000L;
+            limite.tv_sec += limite.tv_nsec / 1000000000L;
+            limite.tv_nsec %= 1000000000L;
+            if (pthread_cond_timedwait(&ha_registros, &trava, &limite) == ETIMEDOUT && fim != inicio)
+                break;
+        }
+        urgente = 0;
+
+        unsigned long ate = fim;
+        if (ate == inicio && encerrando) break;
+
+        pthread_mutex_unlock(&trava);
+        for (unsigned long k = inicio; k < ate; k++) gravar(&anel[k % CAPACIDADE_LOG]);
+        if (arquivo) fflush(arquivo);
+        if (eco_terminal) fflush(stdout);
+        pthread_mutex_lock(&trava);
+
+        inicio = ate;
+        pthread_cond_broadcast(&ha_espaco);
+    }
+
+    pthread_mutex_unlock(&trava);
+    return NULL;
+}
+
+/// Inicia a thread de fundo; chamada com a trava.
+static void iniciar() {
+    static int registrado = 0;
+    if (!registrado) {
+        atexit(log_encerrar);
+        registrado = 1;
+    }
+
+    arquivo = fopen(caminho_log, "a");
+    encerrando = 0;
+    if (pthread_create(&escritor, NULL, escrever, NULL) == 0) ativo = 1;
+}
+
+void log_encerrar() {
+    pthread_mutex_lock(&trava);
+    if (!ativo) {
+        pthread_mutex_unlock(&trava);
+        return;
+    }
+    encerrando = 1;
+    pthread_cond_signal(&ha_registros);
+    pthread_mutex_unlock(&trava);
+
+    pthread_join(escritor, NULL);
+
+    pthread_mutex_lock(&trava);
+    ativo = 0;
+    if (arquivo) fclose(arquivo);
+    arquivo = NULL;
+    pthread_mutex_unlock(&trava);
+}
+
+void log_configurar(const char *caminho, nivel_log_t nivel, int eco) {
+    log_encerrar();
+
+    pthread_mutex_lock(&trava);
+    habilitado = caminho != NULL;
+    if (caminho) snprintf(caminho_log, sizeof(caminho_log), "%s", caminho);
+    nivel_minimo = nivel;
+    eco_terminal = eco;
+    pthread_mutex_unlock(&trava);
+}
+
+int log_nivel_por_nome(const char *nome) {
+    static const char *nomes[] = { "depuracao", "info", "aviso", "erro" };
+    for (int k = 0; k < 4; k++)
+        if (strcmp(nome, nomes[k]) == 0) return k;
+    return -1;
+}
+
+void log_registrar(nivel_log_t nivel, int pid, const char *metodo, const char *motivo) {
+    time_t agora = time(NULL);
+
+    // A configuração é lida com a trava, pois `log_configurar` a muda com ela
+    pthread_mutex_lock(&trava);
+    if (!habilitado || nivel < nivel_minimo) {
+        pthread_mutex_unlock(&trava);
+        return;
+    }
+    if (!ativo) iniciar();
+    if (!ativo) {
+        // Sem thread de fundo, grava diretamente
+        registro_log_t r = { .instante = agora, .nivel = nivel, .pid = pid };
+        snprintf(r.metodo, sizeof(r.metodo), "%s", metodo);
+        snprintf(r.motivo, sizeof(r.motivo), "%s", motivo);
+        gravar(&r);
+        pthread_mutex_unlock(&trava);
+        return;
+    }
+
+    while (fim - inicio == CAPACIDADE_LOG) {
+        pthread_cond_signal(&ha_registros);
+        pthread_cond_wait(&ha_espaco, &trava);
+    }
+
+    registro_log_t *r = &anel[fim % CAPACIDADE_LOG];
+    r->instante = agora;
+    r->nivel = nivel;
+    r->pid = pid;
+    snprintf(r->metodo, sizeof(r->metodo), "%s", metodo);
+    snprintf(r->motivo, sizeof(r->motivo), "%s", motivo);
+    fim++;
+
+    if (fim - inicio == CAPACIDADE_LOG / 2) pthread_cond_signal(&ha_registros);
+    pthread_mutex_unlock(&trava);
+}
+
+void log_erro(int pid, const char *metodo, const char *motivo) {
+    log_registrar(NIVEL_LOG_ERRO, pid, metodo, motivo);
+}
 
-    // Também mostra no terminal
-    printf("[ERRO] Processo %d | %s | %s\n", pid, metodo, motivo);
+void log_descarregar() {
+    pthread_mutex_lock(&trava);
+    unsigned long alvo = fim;
+    while (ativo && inicio < alvo) {
+        urgente = 1;
+        pthread_cond_signal(&ha_registros);
+        pthread_cond_wait(&ha_espaco, &trava);
+    }
+    pthread_mutex_unlock(&trava);
 }
@@ -0,0 +1,136 @@
+/**
+ * @file mapa_ocupacao.c
+ * @brief Implementação do mapa de extensões ocupadas (treap por endereço).
+ */
+
+#include <stdlib.h>
+#include "../include/mapa_ocupacao.h"
+
+/// Estado do gerador pseudoaleatório das prioridades (xorshift32), um por thread
+static _Thread_local unsigned semente = 88675123u;
+
+static unsigned proxima_prioridade() {
+    semente ^= semente << 13;
+    semente ^= semente >> 17;
+    semente ^= semente << 5;
+    return semente;
+}
+
+/// Divide `t` em nós com início < chave (esq) e início >= chave (dir).
+static void dividir(no_ocupado_t *t, bloco_t chave, no_ocupado_t **esq, no_ocupado_t **dir) {
+    if (!t) {
+        *esq = *dir = NULL;
+    } else if (t->inicio < chave) {
+        dividir(t->dir, chave, &t->dir, dir);
+        *esq = t;
+    } else {
+        dividir(t->esq, chave, esq, &t->esq);
+        *dir = t;
+    }
+}
+
+static no_ocupado_t *juntar(no_ocupado_t *a, no_ocupado_t *b) {
+    if (!a) return b;
+    if (!b) return a;
+    if (a->prioridade > b->prioridade) {
+        a->dir = juntar(a->dir, b);
+        return a;
+    }
+    b->esq = juntar(a, b->esq);
+    return b;
+}
+
+static no_ocupado_t *inserir(no_ocupado_t *t, no_ocupado_t *no) {
+    if (!t) return no;
+    if (no->prioridade > t->prioridade) {
+        dividir(t, no->inicio, &no->esq, &no->dir);
+        return no;
+    }
+    if (no->inicio < t->inicio)
+        t->esq = inserir(t->esq, no);
+    else
+        t->dir = inserir(t->dir, no);
+    return t;
+}
+
+static no_ocupado_t *remover(no_ocupado_t *t, bloco_t inicio, no_ocupado_t **removido) {
+    if (!t) return NULL;
+    if (t->inicio == inicio) {
+        *removido = t;
+        return juntar(t->esq, t->dir);
+    }
+    if (inicio < t->inicio)
+        t->esq = remover(t->esq, inicio, removido);
+    else
+        t->dir = remover(t->dir, inicio, removido);
+    return t;
+}
+
+static void liberar_nos(no_ocupado_t *no) {
+    if (!no) return;
+    liberar_nos(no->esq);
+    liberar_nos(no->dir);
+    free(no);
+}
+
+void mapa_limpar(mapa_ocupacao_t *mapa) {
+    liberar_nos(mapa->raiz);
+    mapa->raiz = NULL;
+    mapa->quantidade = 0;
+}
+
+void mapa_inserir(mapa_ocupacao_t *mapa, bloco_t inicio, bloco_t tamanho, int pid) {
+    no_ocupado_t *no = malloc(sizeof(no_ocupado_t));
+    no->inicio = inicio;
+    no->tamanho = tamanho;
+    no->pid = pid;
+    no->desperdicio = 0;
+    no->prioridade = proxima_prioridade();
+    no->esq = no->dir = NULL;
+
+    mapa->raiz = inserir(mapa->raiz, no);
+    mapa->quantidade++;
+}
+
+void mapa_remover(mapa_ocupacao_t *mapa, bloco_t inicio) {
+    no_ocupado_t *removido = NULL;
+    mapa->raiz = remover(mapa->raiz, inicio, &removido);
+    if (removido) {
+        free(removido);
+        mapa->quantidade--;
+    }
+}
+
+no_ocupado_t *mapa_proximo(const mapa_ocupacao_t *mapa, bloco_t endereco) {
+    no_ocupado_t *t = mapa->raiz;
+    no_ocupado_t *candidato = NULL;
+
+    while (t) {
+        if (t->inicio >= endereco) {
+            candidato = t;
+            t = t->esq;
+        } else {
+            t = t->dir;
+        }
+    }
+    return candidato;
+}
+
+no_ocupado_t *mapa_contendo(const mapa_ocupacao_t *mapa, bloco_t endereco) {
+    no_ocupado_t *t = mapa->raiz;
+    no_ocupado_t *candidato = NULL;
+
+    // Última extensão que começa em `endereco` ou antes
+    while (t) {
+        if (t->inicio <= endereco) {
+            candidato = t;
+            t = t->dir;
+        } else {
+            t = t->esq;
+        }
+    }
+
+    if (candidato && endereco < candidato->inicio + candidato->tamanho)
+        return candidato;
+    return NULL;
+}
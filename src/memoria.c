@@ -2,48 +2,210 @@
  * @file memoria.c
  * @brief Implementação das funções de gerenciamento de memória simulada.
  *
- * Este módulo implementa as operações básicas de manipulação de um vetor de memória,
- * representando blocos alocados e liberados para processos.
+ * Este módulo implementa as operações básicas de manipulação da memória simulada,
+ * representada por extensões de blocos alocados e liberados para processos.
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "../include/memoria.h"
+#include "../include/estado_binario.h"
+#include "../include/diario.h"
+#include "../include/buddy.h"
+#include "../include/varredura.h"
+#include "../include/metricas.h"
 
-/// Vetor que representa a memória principal (0 = livre, >0 = PID do processo)
-int memoria[TAM_MEMORIA];
+/// Anota que o trecho [inicio, inicio + tamanho) passou a pertencer a `pid`.
+static void anotar_alteracao(simulador_t *sim, bloco_t inicio, bloco_t tamanho, int pid) {
+    alteracoes_t *a = &sim->alteracoes;
+    if (a->quantidade == LIMITE_ALTERACOES) a->incompleta = 1;
+    if (a->incompleta) return;
+    a->itens[a->quantidade++] = (alteracao_t){ inicio, tamanho, pid };
+}
+
+void alteracoes_zerar(simulador_t *sim) {
+    sim->alteracoes.quantidade = 0;
+    sim->alteracoes.incompleta = 0;
+}
+
+/// Anota, para os instantâneos, que a extensão em `inicio` vai sair do mapa ou mudar.
+static void anotar_saida(simulador_t *sim, bloco_t inicio) {
+    if (sim->instantaneos.num_marcas == 0) return;
+    no_ocupado_t *ext = mapa_proximo(&sim->memoria.ocupadas, inicio);
+    instantaneo_anotar(sim, DESFAZER_SAIDA, ext->inicio, ext->tamanho, ext->pid, ext->desperdicio);
+}
+
+/// Anota, para os instantâneos, que uma extensão entrou no mapa em `inicio`.
+static void anotar_entrada(simulador_t *sim, bloco_t inicio) {
+    instantaneo_anotar(sim, DESFAZER_ENTRADA, inicio, 0, 0, 0);
+}
+
+/// Esvazia todas as estruturas da memória, sem criar a região livre inicial.
+static void limpar_estruturas(simulador_t *sim) {
+    if (sim->instantaneos.num_marcas > 0) {
+        for (no_ocupado_t *ext = mapa_proximo(&sim->memoria.ocupadas, 0); ext;
+             ext = mapa_proximo(&sim->memoria.ocupadas, ext->inicio + 1))
+            anotar_saida(sim, ext->inicio);
+        instantaneo_anotar(sim, DESFAZER_TAMANHO, 0, sim->memoria.tamanho, 0, 0);
+    }
+    sim->alteracoes.incompleta = 1;
+    indice_limpar(&sim->memoria.livres);
+    mapa_limpar(&sim->memoria.ocupadas);
+    tabela_limpar(&sim->memoria.processos);
+    buddy_limpar(sim);
+}
+
+/// Registra uma extensão ocupada no mapa de ocupação e na tabela de processos.
+static void registrar_extensao(simulador_t *sim, bloco_t inicio, bloco_t tamanho, int pid) {
+    mapa_inserir(&sim->memoria.ocupadas, inicio, tamanho, pid);
+    tabela_adicionar(&sim->memoria.processos, pid, inicio, tamanho);
+    anotar_entrada(sim, inicio);
+}
+
+/**
+ * @brief Retorna o PID dono do bloco `i`, avançando um cursor de extensões.
+ *
+ * Usada para percorrer a memória bloco a bloco em ordem crescente de endereço
+ * sem uma busca completa por bloco. O cursor deve começar em
+ * `mapa_proximo(&sim->memoria.ocupadas, 0)`.
+ */
+static int pid_do_bloco(const simulador_t *sim, bloco_t i, no_ocupado_t **cursor) {
+    no_ocupado_t *ext = *cursor;
+    if (ext && i >= ext->inicio + ext->tamanho)
+        ext = *cursor = mapa_proximo(&sim->memoria.ocupadas, i);
+    return (ext && i >= ext->inicio) ? ext->pid : 0;
+}
+
+int simulador_criar(simulador_t *sim, bloco_t tamanho) {
+    if (tamanho < 0) return -1;
+
+    memset(sim, 0, sizeof(*sim));
+    definir_tamanho_memoria(sim, tamanho);
+    return 0;
+}
+
+void simulador_destruir(simulador_t *sim) {
+    diario_fechar(sim);
+    espera_destruir(&sim->espera);
+    instantaneo_destruir(&sim->instantaneos);
+    limpar_estruturas(sim);
+    free(sim->memoria.processos.baldes);
+    sim->memoria.processos.baldes = NULL;
+    sim->memoria.processos.num_baldes = 0;
+}
+
+/**
+ * @brief Redefine o tamanho da memória e marca todos os blocos como livres.
+ *
+ * @param tamanho Novo número de unidades da memória simulada.
+ */
+void definir_tamanho_memoria(simulador_t *sim, bloco_t tamanho) {
+    // A memória é esvaziada antes de mudar de tamanho, para que os instantâneos anotem o tamanho antigo
+    limpar_estruturas(sim);
+    sim->memoria.tamanho = tamanho;
+    if (tamanho > 0)
+        indice_liberar(&sim->memoria.livres, 0, tamanho);
+}
 
 /**
  * @brief Inicializa todos os blocos da memória como livres.
  *
- * A função define todos os valores do vetor `memoria` como 0.
+ * Descarta todas as extensões e cria uma única região livre do tamanho
+ * da memória.
+ */
+void inicializar_memoria(simulador_t *sim) {
+    limpar_estruturas(sim);
+    if (sim->memoria.tamanho > 0)
+        indice_liberar(&sim->memoria.livres, 0, sim->memoria.tamanho);
+}
+
+/**
+ * @brief Ocupa os primeiros blocos de uma região livre com um processo.
+ *
+ * @param regiao Região livre obtida do índice.
+ * @param tamanho Número de blocos a ocupar.
+ * @param pid Identificador do processo dono dos blocos.
+ */
+void ocupar_regiao(simulador_t *sim, no_livre_t *regiao, bloco_t tamanho, int pid) {
+    bloco_t inicio = regiao->inicio;
+    indice_ocupar(&sim->memoria.livres, regiao, tamanho);
+    registrar_extensao(sim, inicio, tamanho, pid);
+    buddy_ocupacao(sim, inicio, tamanho);
+    diario_ocupacao(sim, pid, inicio, tamanho);
+    anotar_alteracao(sim, inicio, tamanho, pid);
+}
+
+/**
+ * @brief Ocupa um intervalo específico da memória com um processo.
+ *
+ * @param inicio Primeiro bloco do intervalo.
+ * @param tamanho Número de blocos.
+ * @param pid Identificador do processo dono dos blocos.
+ * @return int 1 se o intervalo estava livre e foi ocupado, 0 caso contrário.
  */
-void inicializar_memoria() {
-    for (int i = 0; i < TAM_MEMORIA; i++)
-        memoria[i] = 0;
+int ocupar_intervalo(simulador_t *sim, bloco_t inicio, bloco_t tamanho, int pid) {
+    if (pid == 0 || !indice_reservar(&sim->memoria.livres, inicio, tamanho))
+        return 0;
+
+    registrar_extensao(sim, inicio, tamanho, pid);
+    buddy_ocupacao(sim, inicio, tamanho);
+    diario_ocupacao(sim, pid, inicio, tamanho);
+    anotar_alteracao(sim, inicio, tamanho, pid);
+    return 1;
 }
 
 /**
  * @brief Libera todos os blocos ocupados por um processo específico.
  *
- * Substitui por zero todas as posições que contenham o PID fornecido.
+ * Percorre apenas as extensões registradas para o PID na tabela de processos,
+ * removendo-as do mapa de ocupação e devolvendo cada trecho ao índice de
+ * regiões livres.
  *
  * @param pid Identificador do processo a ser removido da memória.
  */
-void liberar_memoria(int pid) {
-    for (int i = 0; i < TAM_MEMORIA; i++)
-        if (memoria[i] == pid)
-            memoria[i] = 0;
+void liberar_memoria(simulador_t *sim, int pid) {
+    marca_metrica_t marca = metricas_iniciar();
+    entrada_pid_t *e = tabela_buscar(&sim->memoria.processos, pid);
+    if (!e) {
+        metricas_registrar(&sim->metricas.liberacoes, marca, 0);
+        return;
+    }
+
+    for (int k = 0; k < e->quantidade; k++) {
+        anotar_saida(sim, e->extensoes[k].inicio);
+        buddy_liberacao(sim, e->extensoes[k].inicio, e->extensoes[k].tamanho);
+        mapa_remover(&sim->memoria.ocupadas, e->extensoes[k].inicio);
+        indice_liberar(&sim->memoria.livres, e->extensoes[k].inicio, e->extensoes[k].tamanho);
+        anotar_alteracao(sim, e->extensoes[k].inicio, e->extensoes[k].tamanho, 0);
+    }
+
+    tabela_remover(&sim->memoria.processos, pid);
+    diario_liberacao(sim, pid);
+    metricas_registrar(&sim->metricas.liberacoes, marca, 1);
+    espera_atender(sim);
 }
 
 /**
  * @brief Imprime o estado atual da memória no terminal.
  *
  * Mostra a memória em blocos de 20 colunas para facilitar a leitura.
+ * Memórias grandes são exibidas como lista de extensões ocupadas.
  */
-void imprimir_memoria() {
-    for (int i = 0; i < TAM_MEMORIA; i++) {
+void imprimir_memoria(simulador_t *sim) {
+    if (sim->memoria.tamanho > LIMITE_FORMATO_PLANO) {
+        printf("\nMemória de %lld blocos, %d extensões ocupadas:\n",
+               sim->memoria.tamanho, sim->memoria.ocupadas.quantidade);
+        for (no_ocupado_t *ext = mapa_proximo(&sim->memoria.ocupadas, 0); ext;
+             ext = mapa_proximo(&sim->memoria.ocupadas, ext->inicio + 1))
+            printf("[%lld, %lld) PID %d\n", ext->inicio, ext->inicio + ext->tamanho, ext->pid);
+        return;
+    }
+
+    no_ocupado_t *cursor = mapa_proximo(&sim->memoria.ocupadas, 0);
+    for (bloco_t i = 0; i < sim->memoria.tamanho; i++) {
         if (i % 20 == 0) printf("\n"); ///< Nova linha a cada 20 blocos
-        printf("%2d ", memoria[i]);
+        printf("%2d ", pid_do_bloco(sim, i, &cursor));
     }
     printf("\n");
 }
@@ -54,90 +216,379 @@ void imprimir_memoria() {
  * Escreve os blocos da memória em uma única linha no formato:
  * `0 0 2 2 0 0 1 ...`
  *
+ * Memórias maiores que `LIMITE_FORMATO_PLANO` são salvas no formato de extensões.
+ *
  * @param arquivo Caminho e nome do arquivo de saída.
  */
-void salvar_memoria(const char *arquivo) {
+void salvar_memoria(simulador_t *sim, const char *arquivo) {
+    if (sim->memoria.tamanho > LIMITE_FORMATO_PLANO) {
+        salvar_memoria_extensoes(sim, arquivo);
+        return;
+    }
+
     FILE *f = fopen(arquivo, "w");
-    for (int i = 0; i < TAM_MEMORIA; i++)
-        fprintf(f, "%d ", memoria[i]);
+    if (!f) return;
+
+    no_ocupado_t *cursor = mapa_proximo(&sim->memoria.ocupadas, 0);
+    for (bloco_t i = 0; i < sim->memoria.tamanho; i++)
+        fprintf(f, "%d ", pid_do_bloco(sim, i, &cursor));
+    fclose(f);
+}
+
+/**
+ * @brief Salva o estado da memória como lista de extensões ocupadas.
+ *
+ * @param arquivo Caminho e nome do arquivo de saída.
+ */
+void salvar_memoria_extensoes(simulador_t *sim, const char *arquivo) {
+    FILE *f = fopen(arquivo, "w");
+    if (!f) return;
+
+    fprintf(f, "extensoes %lld\n", sim->memoria.tamanho);
+    for (no_ocupado_t *ext = mapa_proximo(&sim->memoria.ocupadas, 0); ext;
+         ext = mapa_proximo(&sim->memoria.ocupadas, ext->inicio + 1))
+        fprintf(f, "%lld %lld %d\n", ext->inicio, ext->tamanho, ext->pid);
     fclose(f);
 }
 
 /**
  * @brief Compacta a memória, movendo todos os processos para o início.
  *
- * Blocos livres (0) são empurrados para o final do vetor.
- * Após a operação, todos os blocos ocupados ficam agrupados no início.
+ * As extensões ocupadas são deslocadas para endereços consecutivos a partir
+ * de 0, na mesma ordem em que estavam. Como a ordem relativa não muda, os
+ * nós do mapa de ocupação são atualizados no próprio lugar. Extensões do
+ * mesmo processo que ficam encostadas são unidas. Ao final resta uma única
+ * região livre no fim da memória.
  */
-void compactar_memoria() {
-    int nova_memoria[TAM_MEMORIA];
-    int k = 0;
+void compactar_memoria(simulador_t *sim) {
+    marca_metrica_t marca = metricas_iniciar();
+    bloco_t k = 0, movidos = sim->metricas.movidos;
 
-    // Copia apenas blocos ocupados para o início do novo vetor
-    for (int i = 0; i < TAM_MEMORIA; i++) {
-        if (memoria[i] != 0) {
-            nova_memoria[k++] = memoria[i];
+    tabela_limpar(&sim->memoria.processos);
+    no_ocupado_t *ext = mapa_proximo(&sim->memoria.ocupadas, 0), *anterior = NULL;
+    while (ext) {
+        bloco_t antigo = ext->inicio;
+        if (antigo != k) {
+            sim->metricas.movidos += ext->tamanho;
+            anotar_alteracao(sim, k, ext->tamanho, ext->pid);
         }
+
+        if (anterior && anterior->pid == ext->pid) {
+            // Encosta na extensão anterior do mesmo processo: as duas viram uma
+            anotar_saida(sim, anterior->inicio);
+            anotar_saida(sim, antigo);
+            tabela_buscar_extensao(&sim->memoria.processos, ext->pid, anterior->inicio)->tamanho += ext->tamanho;
+            anterior->tamanho += ext->tamanho;
+            anterior->desperdicio += ext->desperdicio;
+            k += ext->tamanho;
+            mapa_remover(&sim->memoria.ocupadas, antigo);
+            anotar_entrada(sim, anterior->inicio);
+            ext = mapa_proximo(&sim->memoria.ocupadas, antigo + 1);
+            continue;
+        }
+
+        if (antigo != k) {
+            anotar_saida(sim, antigo);
+            anotar_entrada(sim, k);
+        }
+        ext->inicio = k;
+        k += ext->tamanho;
+        tabela_adicionar(&sim->memoria.processos, ext->pid, ext->inicio, ext->tamanho);
+        anterior = ext;
+        ext = mapa_proximo(&sim->memoria.ocupadas, antigo + 1);
+    }
+
+    // Todo o espaço livre passa a ser uma única região no final
+    indice_limpar(&sim->memoria.livres);
+    if (k < sim->memoria.tamanho) {
+        indice_liberar(&sim->memoria.livres, k, sim->memoria.tamanho - k);
+        if (sim->metricas.movidos != movidos) anotar_alteracao(sim, k, sim->memoria.tamanho - k, 0);
     }
 
-    // Preenche o restante com 0 (livre)
-    while (k < TAM_MEMORIA) {
-        nova_memoria[k++] = 0;
+    buddy_invalidar(sim);
+    diario_compactacao(sim);
+    metricas_registrar(&sim->metricas.compactacoes, marca, 1);
+    espera_atender(sim);
+}
+
+int mover_extensao(simulador_t *sim, bloco_t origem, bloco_t destino, bloco_t tamanho) {
+    no_livre_t *buraco = indice_contendo(&sim->memoria.livres, destino);
+    no_ocupado_t *ext = mapa_proximo(&sim->memoria.ocupadas, origem);
+    if (!buraco || buraco->inicio != destino || buraco->inicio + buraco->tamanho != origem ||
+        !ext || ext->inicio != origem || tamanho <= 0 || tamanho > ext->tamanho)
+        return 0;
+
+    int pid = ext->pid;
+    bloco_t vao = origem - destino;
+    no_ocupado_t *anterior = destino > 0 ? mapa_contendo(&sim->memoria.ocupadas, destino - 1) : NULL;
+    int unir = anterior && anterior->pid == pid;
+    int inteira = tamanho == ext->tamanho;
+
+    if (unir) anotar_saida(sim, anterior->inicio);
+    anotar_saida(sim, origem);
+
+    if (unir) {
+        tabela_buscar_extensao(&sim->memoria.processos, pid, anterior->inicio)->tamanho += tamanho;
+        anterior->tamanho += tamanho;
+    }
+
+    if (inteira) {
+        if (unir) {
+            anterior->desperdicio += ext->desperdicio;
+            tabela_remover_extensao(&sim->memoria.processos, pid, origem);
+            mapa_remover(&sim->memoria.ocupadas, origem);
+        } else {
+            tabela_buscar_extensao(&sim->memoria.processos, pid, origem)->inicio = destino;
+            ext->inicio = destino;
+        }
+    } else {
+        // O restante da extensão continua onde está, como uma extensão própria
+        extensao_t *resto = tabela_buscar_extensao(&sim->memoria.processos, pid, origem);
+        resto->inicio += tamanho;
+        resto->tamanho -= tamanho;
+        ext->inicio += tamanho;
+        ext->tamanho -= tamanho;
+        if (!unir) registrar_extensao(sim, destino, tamanho, pid);
+    }
+
+    // O buraco [destino, origem) desliza para depois do trecho movido
+    indice_reservar(&sim->memoria.livres, destino, vao);
+    indice_liberar(&sim->memoria.livres, destino + tamanho, vao);
+    anotar_alteracao(sim, destino, tamanho, pid);
+    anotar_alteracao(sim, destino + tamanho, vao, 0);
+    if (unir) anotar_entrada(sim, anterior->inicio);
+    if (!inteira) anotar_entrada(sim, origem + tamanho);
+    else if (!unir) anotar_entrada(sim, destino);
+
+    buddy_invalidar(sim);
+    diario_movimento(sim, origem, destino, tamanho);
+    return 1;
+}
+
+/// Acrescenta uma entrada ao mapa de realocação de um passo.
+static void anotar_realocacao(passo_compactacao_t *passo, int pid, bloco_t antigo, bloco_t novo, bloco_t tamanho) {
+    if (passo->quantidade == passo->capacidade) {
+        passo->capacidade = passo->capacidade ? passo->capacidade * 2 : 8;
+        passo->realocacoes = realloc(passo->realocacoes, passo->capacidade * sizeof(realocacao_t));
+    }
+    passo->realocacoes[passo->quantidade++] = (realocacao_t){ pid, antigo, novo, tamanho };
+}
+
+void compactar_passo(simulador_t *sim, bloco_t orcamento, passo_compactacao_t *passo) {
+    marca_metrica_t marca = metricas_iniciar();
+    *passo = (passo_compactacao_t){ 0 };
+
+    for (;;) {
+        no_livre_t *buraco = indice_proximo(&sim->memoria.livres, 0);
+        no_ocupado_t *ext = buraco ? mapa_proximo(&sim->memoria.ocupadas, buraco->inicio) : NULL;
+        if (!ext) {
+            passo->concluida = 1;
+            break;
+        }
+
+        if (passo->movidos == orcamento) break;
+
+        // Da extensão que não cabe no orçamento, só o começo: o resto fica para o próximo passo
+        bloco_t origem = ext->inicio, destino = buraco->inicio;
+        bloco_t tamanho = ext->tamanho;
+        if (tamanho > orcamento - passo->movidos) tamanho = orcamento - passo->movidos;
+        int pid = ext->pid;
+
+        mover_extensao(sim, origem, destino, tamanho);
+        anotar_realocacao(passo, pid, origem, destino, tamanho);
+        passo->movidos += tamanho;
+    }
+
+    sim->metricas.movidos += passo->movidos;
+    metricas_registrar(&sim->metricas.compactacoes, marca, 1);
+    espera_atender(sim);
+}
+
+/// O intervalo [inicio, fim) está inteiramente livre? (Vazio conta como livre.)
+static int intervalo_livre(const simulador_t *sim, bloco_t inicio, bloco_t fim) {
+    if (inicio >= fim) return 1;
+    no_livre_t *regiao = indice_contendo(&sim->memoria.livres, inicio);
+    return regiao && regiao->inicio + regiao->tamanho >= fim;
+}
+
+int redimensionar_extensao(simulador_t *sim, bloco_t origem, bloco_t destino, bloco_t tamanho) {
+    no_ocupado_t *ext = mapa_proximo(&sim->memoria.ocupadas, origem);
+    if (!ext || ext->inicio != origem || tamanho < 0 || destino < 0 ||
+        destino + tamanho > sim->memoria.tamanho)
+        return 0;
+
+    int pid = ext->pid;
+    bloco_t antigo = ext->tamanho, fim = destino + tamanho;
+    // Fora da própria extensão, o novo intervalo só pode usar blocos livres
+    if (!intervalo_livre(sim, destino, fim < origem ? fim : origem) ||
+        !intervalo_livre(sim, destino > origem + antigo ? destino : origem + antigo, fim))
+        return 0;
+    if (destino == origem && tamanho == ext->tamanho) return 1;
+    anotar_saida(sim, origem);
+
+    // O pedido passa a ser o novo tamanho: a sobra de um bloco buddy deixa de existir
+    sim->buddy.desperdicio -= ext->desperdicio;
+    ext->desperdicio = 0;
+
+    if (destino == origem && tamanho < antigo) {
+        buddy_liberacao(sim, origem + tamanho, antigo - tamanho);
+        indice_liberar(&sim->memoria.livres, origem + tamanho, antigo - tamanho);
+        anotar_alteracao(sim, origem + tamanho, antigo - tamanho, 0);
+    } else if (destino == origem) {
+        indice_reservar(&sim->memoria.livres, origem + antigo, tamanho - antigo);
+        buddy_ocupacao(sim, origem + antigo, tamanho - antigo);
+        anotar_alteracao(sim, origem + antigo, tamanho - antigo, pid);
+    } else {
+        // Devolver antes de reservar permite que o destino sobreponha a origem
+        indice_liberar(&sim->memoria.livres, origem, antigo);
+        indice_reservar(&sim->memoria.livres, destino, tamanho);
+        anotar_alteracao(sim, origem, antigo, 0);
+        anotar_alteracao(sim, destino, tamanho, pid);
+        buddy_invalidar(sim);
     }
 
-    // Atualiza a memória original
-    for (int i = 0; i < TAM_MEMORIA; i++) {
-        memoria[i] = nova_memoria[i];
+    if (tamanho == 0) {
+        mapa_remover(&sim->memoria.ocupadas, origem);
+        tabela_remover_extensao(&sim->memoria.processos, pid, origem);
+    } else if (destino == origem) {
+        ext->tamanho = tamanho;
+        tabela_buscar_extensao(&sim->memoria.processos, pid, origem)->tamanho = tamanho;
+    } else {
+        // Entre a origem e o destino pode haver outras extensões: o nó muda de posição no mapa
+        mapa_remover(&sim->memoria.ocupadas, origem);
+        mapa_inserir(&sim->memoria.ocupadas, destino, tamanho, pid);
+        *tabela_buscar_extensao(&sim->memoria.processos, pid, origem) = (extensao_t){ destino, tamanho };
     }
+    if (tamanho > 0) anotar_entrada(sim, destino);
+
+    diario_redimensionamento(sim, origem, destino, tamanho);
+    return 1;
+}
+
+/// Índice, em `e->extensoes`, da extensão de maior endereço do processo.
+static int ultima_extensao(const entrada_pid_t *e) {
+    int ultima = 0;
+    for (int k = 1; k < e->quantidade; k++)
+        if (e->extensoes[k].inicio > e->extensoes[ultima].inicio) ultima = k;
+    return ultima;
 }
 
 /**
- * @brief Exibe estatísticas sobre fragmentação externa na memória.
+ * @brief Muda o tamanho de um processo, movendo o mínimo possível.
  *
- * Analisa quantas regiões livres existem, seu tamanho, e detecta
- * se a memória está fragmentada (vários espaços livres pequenos).
+ * Em ordem de preferência:
+ * 1. encolher: o fim das extensões de maior endereço volta a ser livre;
+ * 2. crescer no lugar: a última extensão avança sobre a região livre seguinte;
+ * 3. deslizar: um processo de uma só extensão, entre duas regiões livres que
+ *    juntas bastam, passa para o início da região anterior;
+ * 4. realocar: a estratégia `alocar` escolhe uma região nova e as extensões
+ *    antigas são liberadas (todo o processo é copiado).
  */
-void exibir_fragmentacao() {
-    int total_livres = 0;
-    int num_regioes = 0;
-    int em_regiao = 0;
-    int tam_regiao_atual = 0;
-    int maior_regiao = 0;
-    int menor_regiao = TAM_MEMORIA + 1;
-
-    for (int i = 0; i < TAM_MEMORIA; i++) {
-        if (memoria[i] == 0) {
-            total_livres++;
-            tam_regiao_atual++;
-            if (!em_regiao) {
-                em_regiao = 1;
-                num_regioes++;
+bloco_t realocar_memoria(simulador_t *sim, int pid, bloco_t tamanho, funcao_alocacao_t alocar) {
+    marca_metrica_t marca = metricas_iniciar();
+    entrada_pid_t *e = tabela_buscar(&sim->memoria.processos, pid);
+    bloco_t atual = 0, movidos = -1;
+
+    if (e && tamanho > 0) {
+        for (int k = 0; k < e->quantidade; k++) atual += e->extensoes[k].tamanho;
+        extensao_t ultima = e->extensoes[ultima_extensao(e)];
+        bloco_t fim = ultima.inicio + ultima.tamanho;
+        no_livre_t *seguinte = indice_contendo(&sim->memoria.livres, fim);
+        bloco_t apos = seguinte ? seguinte->inicio + seguinte->tamanho - fim : 0;
+
+        if (tamanho <= atual) {
+            for (bloco_t sobra = atual - tamanho; sobra > 0;) {
+                extensao_t ext = e->extensoes[ultima_extensao(e)];
+                bloco_t corte = ext.tamanho < sobra ? ext.tamanho : sobra;
+                redimensionar_extensao(sim, ext.inicio, ext.inicio, ext.tamanho - corte);
+                sobra -= corte;
             }
+            movidos = 0;
+        } else if (tamanho - atual <= apos) {
+            redimensionar_extensao(sim, ultima.inicio, ultima.inicio, ultima.tamanho + tamanho - atual);
+            movidos = 0;
         } else {
-            if (em_regiao) {
-                if (tam_regiao_atual > maior_regiao) maior_regiao = tam_regiao_atual;
-                if (tam_regiao_atual < menor_regiao) menor_regiao = tam_regiao_atual;
-                tam_regiao_atual = 0;
-                em_regiao = 0;
+            no_livre_t *anterior = e->quantidade == 1 && ultima.inicio > 0
+                ? indice_contendo(&sim->memoria.livres, ultima.inicio - 1) : NULL;
+
+            if (anterior && anterior->tamanho + atual + apos >= tamanho) {
+                redimensionar_extensao(sim, ultima.inicio, anterior->inicio, tamanho);
+                movidos = atual;
+            } else if (alocar) {
+                // As extensões antigas continuam ocupadas durante a busca, como num realloc
+                int quantidade = e->quantidade;
+                extensao_t *antigas = malloc(quantidade * sizeof(extensao_t));
+                memcpy(antigas, e->extensoes, quantidade * sizeof(extensao_t));
+
+                if (alocar(sim, pid, tamanho)) {
+                    for (int k = 0; k < quantidade; k++)
+                        redimensionar_extensao(sim, antigas[k].inicio, antigas[k].inicio, 0);
+                    movidos = atual;
+                }
+                free(antigas);
             }
         }
     }
 
-    // Se terminou em uma região livre, contabilizar a última
-    if (em_regiao) {
-        if (tam_regiao_atual > maior_regiao) maior_regiao = tam_regiao_atual;
-        if (tam_regiao_atual < menor_regiao) menor_regiao = tam_regiao_atual;
+    if (movidos >= 0) {
+        sim->metricas.realocados += movidos;
+        sim->metricas.preservados += (atual < tamanho ? atual : tamanho) - movidos;
+        espera_atender(sim);
+    }
+    metricas_registrar(&sim->metricas.realocacoes, marca, movidos >= 0);
+    return movidos;
+}
+
+/**
+ * @brief Lê as estatísticas de fragmentação mantidas pelo índice de regiões livres.
+ *
+ * A maior região é o máximo da raiz da árvore por endereço; as demais
+ * grandezas são contadores atualizados a cada inserção e remoção de região.
+ *
+ * @param frag Estrutura que recebe as estatísticas.
+ */
+void calcular_fragmentacao(const simulador_t *sim, fragmentacao_t *frag) {
+    const indice_livre_t *livres = &sim->memoria.livres;
+
+    frag->livres = livres->total;
+    frag->regioes = livres->quantidade;
+    frag->maior = livres->por_endereco ? livres->por_endereco->maior : 0;
+    frag->menor = livres->menor;
+    frag->interna = buddy_desperdicio(sim);
+    frag->indice = frag->livres ? 1.0 - (double)frag->maior / frag->livres : 0.0;
+
+    frag->faixas = 0;
+    for (int k = 0; k < FAIXAS_HISTOGRAMA; k++) {
+        frag->histograma[k] = livres->histograma[k];
+        if (frag->histograma[k]) frag->faixas = k + 1;
     }
+}
+
+/**
+ * @brief Exibe estatísticas sobre fragmentação externa na memória.
+ *
+ * Analisa quantas regiões livres existem, seu tamanho, e detecta
+ * se a memória está fragmentada (vários espaços livres pequenos).
+ */
+void exibir_fragmentacao(simulador_t *sim) {
+    fragmentacao_t frag;
+    calcular_fragmentacao(sim, &frag);
 
     printf("\n=== Fragmentação Externa ===\n");
-    printf("Blocos livres totais: %d\n", total_livres);
-    printf("Número de regiões livres: %d\n", num_regioes);
-    if (num_regioes > 0) {
-        printf("Maior região livre: %d blocos\n", maior_regiao);
-        printf("Menor região livre: %d blocos\n", menor_regiao);
+    printf("Blocos livres totais: %lld\n", frag.livres);
+    printf("Número de regiões livres: %d\n", frag.regioes);
+    if (frag.regioes > 0) {
+        printf("Maior região livre: %lld blocos\n", frag.maior);
+        printf("Menor região livre: %lld blocos\n", frag.menor);
     }
+    if (frag.interna > 0)
+        printf("Fragmentação interna (buddy): %lld blocos\n", frag.interna);
+    printf("Índice de fragmentação: %.3f\n", frag.indice);
+    for (int k = 0; k < frag.faixas; k++)
+        if (frag.histograma[k])
+            printf("  regiões com %lld a %lld blocos: %d\n", 1LL << k, (2LL << k) - 1, frag.histograma[k]);
 
-    if (num_regioes > 1) {
+    if (frag.regioes > 1) {
         printf("Status: HÁ fragmentação externa.\n");
     } else {
         printf("Status: NÃO há fragmentação externa.\n");
@@ -145,37 +596,203 @@ void exibir_fragmentacao() {
     printf("============================\n");
 }
 
+/**
+ * @brief Começa a recriar a memória a partir de uma lista de extensões.
+ *
+ * @param tamanho Número de unidades da memória.
+ */
+void iniciar_montagem(simulador_t *sim, bloco_t tamanho) {
+    limpar_estruturas(sim);
+    sim->memoria.tamanho = tamanho;
+    sim->fim_montagem = 0;
+}
+
+/**
+ * @brief Acrescenta uma extensão ocupada à montagem em andamento.
+ *
+ * O espaço entre a extensão anterior e esta vira uma região livre.
+ *
+ * @return int 1 se a extensão foi aceita, 0 se for inválida ou fora de ordem.
+ */
+int montar_extensao(simulador_t *sim, bloco_t inicio, bloco_t tamanho, int pid) {
+    if (pid == 0 || tamanho <= 0 || inicio < sim->fim_montagem || inicio + tamanho > sim->memoria.tamanho)
+        return 0;
+
+    if (inicio > sim->fim_montagem)
+        indice_liberar(&sim->memoria.livres, sim->fim_montagem, inicio - sim->fim_montagem);
+    registrar_extensao(sim, inicio, tamanho, pid);
+    sim->fim_montagem = inicio + tamanho;
+    return 1;
+}
+
+/**
+ * @brief Conclui a montagem, liberando o espaço após a última extensão.
+ */
+void concluir_montagem(simulador_t *sim) {
+    if (sim->fim_montagem < sim->memoria.tamanho)
+        indice_liberar(&sim->memoria.livres, sim->fim_montagem, sim->memoria.tamanho - sim->fim_montagem);
+}
+
+/**
+ * @brief Lê o formato de extensões (após o cabeçalho `extensoes`).
+ *
+ * As extensões devem estar em ordem crescente de endereço e sem sobreposição,
+ * como escritas por `salvar_memoria_extensoes`; linhas inválidas são ignoradas.
+ * Os espaços entre extensões consecutivas viram regiões livres.
+ *
+ * @return int 0 em caso de sucesso, -1 (memória intocada) se o tamanho for inválido.
+ */
+static int carregar_extensoes(simulador_t *sim, FILE *f) {
+    bloco_t tamanho;
+    if (fscanf(f, "%lld", &tamanho) != 1 || tamanho <= 0)
+        return -1;
+
+    bloco_t inicio, tam;
+    int pid;
+
+    iniciar_montagem(sim, tamanho);
+    while (fscanf(f, "%lld %lld %d", &inicio, &tam, &pid) == 3)
+        montar_extensao(sim, inicio, tam, pid);
+    concluir_montagem(sim);
+    return 0;
+}
+
+/// Número de valores do formato bloco a bloco lidos por vez
+#define LOTE_PLANO 65536
+
+/**
+ * @brief Lê até `max` inteiros separados por espaços.
+ *
+ * Equivale a repetir `fscanf(f, "%d", ...)`, parando no fim do arquivo ou no
+ * primeiro caractere que não forme um número, mas sem o custo de uma chamada
+ * de formatação por bloco.
+ *
+ * @return size_t Número de valores lidos.
+ */
+static size_t ler_valores(FILE *f, int *valores, size_t max) {
+    size_t n = 0;
+    int c = getc_unlocked(f);
+
+    while (n < max) {
+        while (c == ' ' || c == '\n' || c == '\t' || c == '\r') c = getc_unlocked(f);
+
+        int negativo = 0;
+        if (c == '-' || c == '+') {
+            negativo = c == '-';
+            c = getc_unlocked(f);
+        }
+        if (c < '0' || c > '9') break;
+
+        int valor = 0;
+        while (c >= '0' && c <= '9') {
+            valor = valor * 10 + (c - '0');
+            c = getc_unlocked(f);
+        }
+        valores[n++] = negativo ? -valor : valor;
+    }
+
+    if (c != EOF) ungetc(c, f);
+    return n;
+}
+
+/// Registra a sequência [inicio, fim) de blocos iguais a `pid`.
+static void registrar_sequencia(simulador_t *sim, bloco_t inicio, bloco_t fim, int pid) {
+    if (fim <= inicio) return;
+    if (pid == 0) indice_liberar(&sim->memoria.livres, inicio, fim - inicio);
+    else registrar_extensao(sim, inicio, fim - inicio, pid);
+}
+
+/**
+ * @brief Lê o formato bloco a bloco, agrupando blocos iguais em extensões.
+ *
+ * Os valores são lidos em lotes e o fim de cada sequência de blocos iguais é
+ * achado com `varredura_comprimento`, que compara vários blocos por vez.
+ * São lidos no máximo `sim->memoria.tamanho` valores; blocos ausentes no arquivo
+ * ficam livres.
+ */
+static void carregar_plano(simulador_t *sim, FILE *f) {
+    int *valores = malloc(LOTE_PLANO * sizeof(int));
+    bloco_t base = 0;   // endereço de valores[0]
+    bloco_t inicio = 0; // início da sequência atual
+    int pid_atual = 0;
+    size_t n;
+
+    while (base < sim->memoria.tamanho) {
+        bloco_t restante = sim->memoria.tamanho - base;
+        n = ler_valores(f, valores, restante < LOTE_PLANO ? (size_t)restante : LOTE_PLANO);
+        if (n == 0) break;
+
+        size_t j = 0;
+        while (j < n) {
+            if (valores[j] != pid_atual) {
+                registrar_sequencia(sim, inicio, base + j, pid_atual);
+                inicio = base + j;
+                pid_atual = valores[j];
+            }
+            j += varredura_comprimento(valores + j, n - j, pid_atual);
+        }
+        base += n;
+    }
+    free(valores);
+
+    registrar_sequencia(sim, inicio, base, pid_atual);
+    if (base < sim->memoria.tamanho)
+        indice_liberar(&sim->memoria.livres, base, sim->memoria.tamanho - base);
+}
+
 /**
  * @brief Carrega o estado da memória a partir de um arquivo texto.
  *
- * Cada linha (ou valor) no arquivo representa um bloco de memória:
+ * No formato bloco a bloco, cada valor no arquivo representa um bloco de memória:
  * - 0 = bloco livre
  * - >0 = PID do processo que ocupa o bloco
  *
- * Se o arquivo não existir, a memória permanece inalterada.
+ * Arquivos que começam com a palavra `extensoes` são lidos no formato de
+ * extensões, que também define o tamanho da memória. Arquivos binários
+ * (ver `estado_binario.h`) também são reconhecidos pelo cabeçalho.
+ *
+ * Se o arquivo não existir ou for inválido, a memória não é alterada.
+ *
+ * A montagem não passa pelo diário: com diário aberto, um checkpoint do
+ * estado carregado é gravado ao final, como em `instantaneo_restaurar`.
  *
  * @param arquivo Caminho para o arquivo contendo o estado salvo da memória.
+ * @return int 0 em caso de sucesso, -1 se o arquivo não pôde ser carregado.
  */
-void carregar_memoria(const char *arquivo) {
-    FILE *f = fopen(arquivo, "r");
-    if (!f) return;
+int carregar_memoria(simulador_t *sim, const char *arquivo) {
+    int resultado = 0;
 
-    for (int i = 0; i < TAM_MEMORIA && !feof(f); i++) {
-        fscanf(f, "%d", &memoria[i]);
+    if (arquivo_binario(arquivo)) {
+        resultado = carregar_memoria_binaria(sim, arquivo);
+        if (resultado < 0) fprintf(stderr, "Erro: estado binário inválido: %s\n", arquivo);
+    } else {
+        FILE *f = fopen(arquivo, "r");
+        if (!f) return -1;
+
+        char cabecalho[16] = "";
+        long posicao = ftell(f);
+        if (fscanf(f, "%15s", cabecalho) == 1 && strcmp(cabecalho, "extensoes") == 0) {
+            resultado = carregar_extensoes(sim, f);
+        } else {
+            fseek(f, posicao, SEEK_SET);
+            limpar_estruturas(sim);
+            carregar_plano(sim, f);
+        }
+        fclose(f);
     }
 
-    fclose(f);
+    if (resultado == 0) diario_checkpoint(sim);
+    return resultado;
 }
+
 /**
  * @brief Verifica se o PID já está presente na memória.
  * 
  * @param pid Identificador do processo.
  * @return int Retorna 1 se já existe, 0 se não.
  */
-int pid_existe(int pid) {
-    for (int i = 0; i < TAM_MEMORIA; i++) {
-        if (memoria[i] == pid)
-            return 1;
-    }
-    return 0;
+int pid_existe(const simulador_t *sim, int pid) {
+    // PID 0 marca blocos livres: "existe" sempre que houver espaço livre
+    if (pid == 0) return sim->memoria.livres.quantidade > 0;
+    return tabela_buscar(&sim->memoria.processos, pid) != NULL;
 }
@@ -0,0 +1,66 @@
+/**
+ * @file metricas.c
+ * @brief Implementação das métricas do alocador.
+ */
+
+#include <string.h>
+#include <time.h>
+#include "../include/metricas.h"
+#include "../include/indice_livre.h"
+
+static long long agora_ns() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+marca_metrica_t metricas_iniciar() {
+    return (marca_metrica_t){ agora_ns(), visitas_indice.regioes, visitas_indice.blocos };
+}
+
+void metricas_registrar(metricas_operacao_t *op, marca_metrica_t marca, int sucesso) {
+    long long ns = agora_ns() - marca.ns;
+    int faixa = ns > 1 ? 63 - __builtin_clzll(ns) : 0;
+    if (faixa >= FAIXAS_LATENCIA) faixa = FAIXAS_LATENCIA - 1;
+
+    op->chamadas++;
+    if (sucesso) op->sucessos++;
+    else op->falhas++;
+    op->regioes_visitadas += visitas_indice.regioes - marca.regioes;
+    op->blocos_examinados += visitas_indice.blocos - marca.blocos;
+    op->latencia[faixa]++;
+}
+
+void metricas_zerar(metricas_t *metricas) {
+    memset(metricas, 0, sizeof(*metricas));
+}
+
+static void operacao_json(FILE *saida, const char *nome, const metricas_operacao_t *op) {
+    int faixas = FAIXAS_LATENCIA;
+    while (faixas > 0 && op->latencia[faixas - 1] == 0) faixas--;
+
+    fprintf(saida, "\"%s\":{\"chamadas\":%ld,\"sucessos\":%ld,\"falhas\":%ld,\"regioes\":%ld,"
+                   "\"blocos\":%ld,\"latencia_ns\":[",
+            nome, op->chamadas, op->sucessos, op->falhas, op->regioes_visitadas, op->blocos_examinados);
+    for (int k = 0; k < faixas; k++)
+        fprintf(saida, k ? ",%ld" : "%ld", op->latencia[k]);
+    fputs("]}", saida);
+}
+
+void metricas_json(const metricas_t *metricas, FILE *saida) {
+    fputc('{', saida);
+    for (int e = 0; e < NUM_ESTRATEGIAS; e++) {
+        if (metricas->estrategias[e].chamadas == 0) continue;
+        operacao_json(saida, nomes_estrategias[e], &metricas->estrategias[e]);
+        fputc(',', saida);
+    }
+    operacao_json(saida, "liberar", &metricas->liberacoes);
+    fputc(',', saida);
+    operacao_json(saida, "compactar", &metricas->compactacoes);
+    fputc(',', saida);
+    operacao_json(saida, "realocar", &metricas->realocacoes);
+    fputc(',', saida);
+    operacao_json(saida, "lote", &metricas->lotes);
+    fprintf(saida, ",\"movidos\":%lld,\"realocados\":%lld,\"preservados\":%lld}",
+            metricas->movidos, metricas->realocados, metricas->preservados);
+}
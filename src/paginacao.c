@@ -0,0 +1,254 @@
+/**
+ * @file paginacao.c
+ * @brief Implementação do modelo de paginação com TLB e substituição de páginas.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/paginacao.h"
+
+const char *const nomes_substituicao[] = { "fifo", "lru", "clock", NULL };
+
+int substituicao_por_nome(const char *nome) {
+    for (int k = 0; nomes_substituicao[k]; k++)
+        if (strcmp(nome, nomes_substituicao[k]) == 0) return k;
+    return -1;
+}
+
+/// Posição inicial de uma chave na tabela de páginas.
+static inline unsigned long long posicao(const paginacao_t *p, unsigned long long chave) {
+    return ((chave * 0x9E3779B97F4A7C15ULL) >> 32) & p->mascara;
+}
+
+/// Quadro que contém a página, ou -1 se ela não estiver residente.
+static int tabela_buscar_pagina(const paginacao_t *p, unsigned long long chave) {
+    for (unsigned long long i = posicao(p, chave);; i = (i + 1) & p->mascara) {
+        int q = p->tabela[i];
+        if (q < 0 || p->quadros[q].chave == chave) return q;
+    }
+}
+
+static void tabela_inserir_pagina(paginacao_t *p, int q) {
+    unsigned long long i = posicao(p, p->quadros[q].chave);
+    while (p->tabela[i] >= 0) i = (i + 1) & p->mascara;
+    p->tabela[i] = q;
+}
+
+/// Remove a página do quadro `q`, trazendo para trás as entradas que sondaram além dela.
+static void tabela_remover_pagina(paginacao_t *p, int q) {
+    unsigned long long i = posicao(p, p->quadros[q].chave);
+    while (p->tabela[i] != q) i = (i + 1) & p->mascara;
+
+    for (unsigned long long j = (i + 1) & p->mascara; p->tabela[j] >= 0; j = (j + 1) & p->mascara) {
+        unsigned long long origem = posicao(p, p->quadros[p->tabela[j]].chave);
+        // A entrada em j pode ocupar o buraco i se sua posição inicial não estiver em (i, j]
+        if (((j - origem) & p->mascara) >= ((j - i) & p->mascara)) {
+            p->tabela[i] = p->tabela[j];
+            i = j;
+        }
+    }
+    p->tabela[i] = -1;
+}
+
+/// Retira o quadro `q` de uma lista.
+static void desencadear(elo_t *elos, lista_quadros_t *lista, int q) {
+    elo_t *e = &elos[q];
+    if (e->anterior >= 0) elos[e->anterior].proximo = e->proximo;
+    else lista->antigo = e->proximo;
+    if (e->proximo >= 0) elos[e->proximo].anterior = e->anterior;
+    else lista->novo = e->anterior;
+}
+
+/// Põe o quadro `q` no fim (mais recente) de uma lista.
+static void encadear(elo_t *elos, lista_quadros_t *lista, int q) {
+    elos[q] = (elo_t){ lista->novo, -1 };
+    if (lista->novo >= 0) elos[lista->novo].proximo = q;
+    else lista->antigo = q;
+    lista->novo = q;
+}
+
+/// Move o quadro `q` para o fim de uma lista.
+static void renovar(elo_t *elos, lista_quadros_t *lista, int q) {
+    if (lista->novo == q) return;
+    desencadear(elos, lista, q);
+    encadear(elos, lista, q);
+}
+
+/// Descarta a tradução da página do quadro `q` da TLB.
+static void tlb_remover(paginacao_t *p, int q) {
+    desencadear(p->elos_tlb, &p->tlb, q);
+    p->quadros[q].na_tlb = 0;
+    p->ocupadas_tlb--;
+}
+
+/// Guarda a tradução da página do quadro `q`, substituindo a usada há mais tempo.
+static void tlb_inserir(paginacao_t *p, int q) {
+    if (p->entradas_tlb == 0) return;
+    if (p->ocupadas_tlb == p->entradas_tlb) tlb_remover(p, p->tlb.antigo);
+    encadear(p->elos_tlb, &p->tlb, q);
+    p->quadros[q].na_tlb = 1;
+    p->ocupadas_tlb++;
+}
+
+/// Retira a página residente no quadro `q`.
+static void descartar_pagina(paginacao_t *p, int q) {
+    tabela_remover_pagina(p, q);
+    if (p->quadros[q].na_tlb) tlb_remover(p, q);
+    if (p->politica != SUBSTITUICAO_CLOCK) desencadear(p->elos_fila, &p->fila, q);
+    p->quadros[q].chave = 0;
+}
+
+/// Escolhe o quadro para uma página nova: um livre ou, se não houver, uma vítima.
+static int obter_quadro(paginacao_t *p) {
+    if (p->num_livres > 0) return p->livres[--p->num_livres];
+
+    int q;
+    if (p->politica == SUBSTITUICAO_CLOCK) {
+        // Segunda chance: páginas referenciadas perdem o bit e são puladas
+        while (p->quadros[p->ponteiro].referencia) {
+            p->quadros[p->ponteiro].referencia = 0;
+            p->ponteiro = (p->ponteiro + 1) % p->num_quadros;
+        }
+        q = p->ponteiro;
+        p->ponteiro = (p->ponteiro + 1) % p->num_quadros;
+    } else {
+        q = p->fila.antigo;
+    }
+
+    descartar_pagina(p, q);
+    p->contadores.substituicoes++;
+    return q;
+}
+
+int paginacao_criar(paginacao_t *p, bloco_t tamanho_memoria, bloco_t tamanho_pagina,
+                    int entradas_tlb, politica_substituicao_t politica) {
+    if (tamanho_pagina <= 0 || tamanho_memoria < tamanho_pagina || entradas_tlb < 0 ||
+        politica >= NUM_SUBSTITUICOES || tamanho_memoria / tamanho_pagina > (1 << 30))
+        return -1;
+
+    memset(p, 0, sizeof(*p));
+    p->tamanho_pagina = tamanho_pagina;
+    p->num_quadros = tamanho_memoria / tamanho_pagina;
+    p->politica = politica;
+    p->fila = p->tlb = (lista_quadros_t){ -1, -1 };
+
+    p->quadros = calloc(p->num_quadros, sizeof(quadro_t));
+    p->elos_fila = malloc(p->num_quadros * sizeof(elo_t));
+    p->elos_tlb = malloc(p->num_quadros * sizeof(elo_t));
+    p->livres = malloc(p->num_quadros * sizeof(int));
+    // Quadros livres saem em ordem crescente de endereço
+    for (int q = 0; q < p->num_quadros; q++) p->livres[q] = p->num_quadros - 1 - q;
+    p->num_livres = p->num_quadros;
+
+    // No máximo uma página por quadro: com capacidade >= 2x, a ocupação fica abaixo de 50%
+    unsigned long long capacidade = 16;
+    while (capacidade < 2ULL * p->num_quadros) capacidade *= 2;
+    p->mascara = capacidade - 1;
+    p->tabela = malloc(capacidade * sizeof(int));
+    memset(p->tabela, -1, capacidade * sizeof(int));
+
+    p->entradas_tlb = entradas_tlb;
+    return 0;
+}
+
+void paginacao_destruir(paginacao_t *p) {
+    free(p->quadros);
+    free(p->livres);
+    free(p->elos_fila);
+    free(p->elos_tlb);
+    free(p->tabela);
+    memset(p, 0, sizeof(*p));
+}
+
+int paginacao_acessar(paginacao_t *p, int pid, bloco_t endereco) {
+    if (pid <= 0 || pid >= (1 << 24) || endereco < 0) return -1;
+    long long pagina = endereco / p->tamanho_pagina;
+    if (pagina >= 1LL << BITS_PAGINA) return -1;
+
+    unsigned long long chave = chave_pagina(pid, pagina);
+    int q = tabela_buscar_pagina(p, chave);
+    p->contadores.acessos++;
+
+    if (q >= 0 && p->quadros[q].na_tlb) {
+        p->contadores.acertos_tlb++;
+        renovar(p->elos_tlb, &p->tlb, q);
+    } else {
+        if (q < 0) {
+            p->contadores.faltas++;
+            q = obter_quadro(p);
+            p->quadros[q].chave = chave;
+            tabela_inserir_pagina(p, q);
+            if (p->politica != SUBSTITUICAO_CLOCK) encadear(p->elos_fila, &p->fila, q);
+        }
+        tlb_inserir(p, q);
+    }
+
+    // O LRU move o quadro para o fim da fila; o Clock marca a referência
+    if (p->politica == SUBSTITUICAO_LRU) renovar(p->elos_fila, &p->fila, q);
+    p->quadros[q].referencia = 1;
+    return q;
+}
+
+void paginacao_liberar(paginacao_t *p, int pid) {
+    if (pid <= 0 || pid >= (1 << 24)) return;
+
+    for (int q = 0; q < p->num_quadros; q++)
+        if (p->quadros[q].chave >> BITS_PAGINA == (unsigned long long)pid) {
+            descartar_pagina(p, q);
+            p->quadros[q].referencia = 0;
+            p->livres[p->num_livres++] = q;
+        }
+    p->contadores.liberacoes++;
+}
+
+void paginacao_reproduzir(paginacao_t *p, const trace_paginacao_t *trace) {
+    for (long k = 0; k < trace->quantidade; k++) {
+        const referencia_t *r = &trace->referencias[k];
+        if (r->endereco >= 0) paginacao_acessar(p, r->pid, r->endereco);
+        else paginacao_liberar(p, r->pid);
+    }
+}
+
+static void acrescentar(trace_paginacao_t *trace, int pid, bloco_t endereco) {
+    if (trace->quantidade == trace->capacidade) {
+        trace->capacidade = trace->capacidade ? 2 * trace->capacidade : 4096;
+        trace->referencias = realloc(trace->referencias, trace->capacidade * sizeof(referencia_t));
+    }
+    trace->referencias[trace->quantidade++] = (referencia_t){ pid, endereco };
+}
+
+int trace_paginacao_carregar(const char *arquivo, trace_paginacao_t *trace) {
+    FILE *f = strcmp(arquivo, "-") == 0 ? stdin : fopen(arquivo, "r");
+    if (!f) return -1;
+
+    memset(trace, 0, sizeof(*trace));
+    char linha[128];
+
+    while (fgets(linha, sizeof(linha), f)) {
+        char *c = linha, *fim;
+        while (*c == ' ' || *c == '\t') c++;
+        if (*c == '#' || *c == '\n' || *c == '\0') continue;
+
+        if (strncmp(c, "liberar", 7) == 0) {
+            long pid = strtol(c + 7, &fim, 10);
+            if (fim != c + 7 && pid > 0) acrescentar(trace, (int)pid, -1);
+            continue;
+        }
+
+        // Conversão direta: o trace pode ter milhões de linhas
+        long pid = strtol(c, &fim, 10);
+        if (fim == c || pid <= 0) continue;
+        c = fim;
+        long long endereco = strtoll(c, &fim, 0);
+        if (fim != c && endereco >= 0) acrescentar(trace, (int)pid, endereco);
+    }
+
+    if (f != stdin) fclose(f);
+    return 0;
+}
+
+void trace_paginacao_liberar(trace_paginacao_t *trace) {
+    free(trace->referencias);
+    memset(trace, 0, sizeof(*trace));
+}
@@ -6,70 +6,291 @@
  * arquivo texto (`comando.txt`), executa as operações com base nas estratégias
  * definidas (First Fit, Best Fit, Worst Fit) e atualiza o estado da memória em
  * um arquivo de saída (`estado.txt`).
+ *
+ * No modo lote (`--lote`), um trace inteiro de comandos é executado em uma
+ * única invocação, sem reler e regravar o estado a cada comando. Nos modos
+ * servidor (`--pipe` e `--servidor`), o processo fica residente atendendo
+ * comandos até ser encerrado. No modo de comparação (`--comparar`), um trace
+ * é reproduzido em paralelo para várias estratégias e tamanhos de memória.
+ * No modo de paginação (`--paginacao`), um trace de referências é reproduzido
+ * no modelo paginado (ver `paginacao.h`) para cada política de substituição.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include "memoria.h"
+#include "comandos.h"
+#include "servidor.h"
+#include "diario.h"
 #include "alocacao.h"
+#include "comparacao.h"
+#include "paginacao.h"
+#include "metricas.h"
+#include "log.h"
 
 /**
  * @brief Lê e interpreta o comando no arquivo especificado.
  *
- * Os comandos suportados são:
- * - `alocar <pid> <tamanho> <algoritmo>` — aloca blocos para um processo usando a estratégia definida.
- * - `liberar <pid>` — libera todos os blocos ocupados por um processo.
- *
- * Se o PID já estiver presente na memória e for solicitada uma alocação,
- * o comando é ignorado com uma mensagem de erro.
+ * Apenas a primeira linha do arquivo é executada (ver `executar_comando`).
+ * Em caso de falha, a mensagem é impressa com o prefixo `Erro:`, que a
+ * interface gráfica usa para detectar erros.
  *
  * Exemplo de conteúdo do arquivo:
  * ```
  * alocar 3 12 best
- * liberar 3
  * ```
  *
+ * @param sim Simulação sobre a qual o comando atua.
  * @param arquivo_comando Caminho do arquivo contendo o comando a ser processado.
  */
-void processar_comando(const char *arquivo_comando) {
+void processar_comando(simulador_t *sim, const char *arquivo_comando) {
     FILE *f = fopen(arquivo_comando, "r");
     if (!f) {
         perror("Erro ao abrir comando.txt");
         return;
     }
 
-    char comando[16], algoritmo[16];
-    int pid, tamanho;
+    char linha[TAM_LINHA], erro[128];
+    if (fgets(linha, sizeof(linha), f) &&
+        executar_comando(sim, linha, stdout, erro, sizeof(erro)) == COMANDO_FALHOU)
+        printf("Erro: %s\n", erro);
+
+    fclose(f);
+}
+
+/**
+ * @brief Executa em sequência todos os comandos de um fluxo.
+ *
+ * Cada linha é um comando aceito por `executar_comando`; linhas vazias e
+ * linhas iniciadas por `#` são ignoradas. O estado fica apenas na memória
+ * do processo; gravações intermediárias seguem `definir_checkpoint`.
+ *
+ * Para cada comando é escrita uma linha em `saida` (ver `responder_comando`).
+ * No modo interativo (`--pipe`), a resposta é enviada imediatamente após
+ * cada comando; caso contrário, um resumo é escrito na saída de erro ao final.
+ * Os comandos `sair` e `desligar` encerram a leitura, assim como SIGINT e
+ * SIGTERM depois de `instalar_sinais_encerramento` (a leitura interrompida
+ * não é executada).
+ *
+ * @param sim Simulação sobre a qual os comandos atuam.
+ * @param entrada Fluxo com os comandos (arquivo ou stdin).
+ * @param saida Fluxo que recebe o resultado de cada comando.
+ * @param interativo Se diferente de zero, descarrega a saída a cada resposta.
+ */
+static void processar_lote(simulador_t *sim, FILE *entrada, FILE *saida, int interativo) {
+    char linha[TAM_LINHA];
+    long executados = 0, falhas = 0, enfileirados = 0;
+
+    while (!encerramento_pedido() && fgets(linha, sizeof(linha), entrada)) {
+        if (encerramento_pedido()) break;
+        resultado_comando_t r = responder_comando(sim, linha, saida);
+        if (interativo) fflush(saida);
+
+        if (r == COMANDO_IGNORADO) continue;
+        if (r == COMANDO_SAIR || r == COMANDO_DESLIGAR) break;
+        if (r == COMANDO_FALHOU) falhas++;
+        if (r == COMANDO_ENFILEIRADO) enfileirados++;
+        executados++;
+    }
+
+    fflush(saida);
+    log_descarregar();
+    if (!interativo)
+        fprintf(stderr, "%ld comandos executados, %ld falhas, %ld à espera de espaço\n", executados, falhas,
+                enfileirados);
+}
 
-    fscanf(f, "%s", comando);
-    if (strcmp(comando, "alocar") == 0) {
-        fscanf(f, "%d %d %s", &pid, &tamanho, algoritmo);
+/// Número máximo de itens em `--estrategias` e `--tamanhos`
+#define MAX_ITENS_COMPARACAO 64
 
-        if (pid_existe(pid)) {
-            printf("Erro: processo %d já está alocado.\n", pid);
-            fclose(f);
-            return;
+/**
+ * @brief Interpreta uma lista de tamanhos de memória separados por vírgula.
+ *
+ * @param lista Lista (alterada por `strtok`), ou NULL para usar só `tamanho_padrao`.
+ * @param tamanho_padrao Tamanho usado quando a lista não é informada.
+ * @param tamanhos Recebe até `MAX_ITENS_COMPARACAO` tamanhos.
+ * @return int Número de tamanhos, ou -1 (com mensagem) se algum for inválido.
+ */
+static int ler_tamanhos(char *lista, bloco_t tamanho_padrao, bloco_t *tamanhos) {
+    int num_tamanhos = 0;
+    if (!lista) {
+        tamanhos[num_tamanhos++] = tamanho_padrao;
+        return num_tamanhos;
+    }
+
+    for (char *t = strtok(lista, ","); t && num_tamanhos < MAX_ITENS_COMPARACAO; t = strtok(NULL, ",")) {
+        tamanhos[num_tamanhos] = strtoll(t, NULL, 10);
+        if (tamanhos[num_tamanhos] <= 0) {
+            fprintf(stderr, "Erro: tamanho de memória inválido: %s\n", t);
+            return -1;
         }
+        num_tamanhos++;
+    }
+    return num_tamanhos;
+}
 
-        int sucesso = 0;
-        if (strcmp(algoritmo, "first") == 0)
-            sucesso = first_fit(pid, tamanho);
-        else if (strcmp(algoritmo, "best") == 0)
-            sucesso = best_fit(pid, tamanho);
-        else if (strcmp(algoritmo, "worst") == 0)
-            sucesso = worst_fit(pid, tamanho);
+/**
+ * @brief Executa o modo de comparação e imprime a tabela em `stdout`.
+ *
+ * @param arquivo_trace Trace de comandos (`-` para stdin).
+ * @param lista_estrategias Nomes separados por vírgula, ou NULL para todas.
+ * @param lista_tamanhos Tamanhos separados por vírgula, ou NULL para `tamanho_padrao`.
+ * @param tamanho_padrao Tamanho da memória quando nenhum é informado.
+ * @return int Código de saída do programa.
+ */
+static int executar_comparacao(const char *arquivo_trace, char *lista_estrategias,
+                               char *lista_tamanhos, bloco_t tamanho_padrao) {
+    const char *estrategias[MAX_ITENS_COMPARACAO];
+    bloco_t tamanhos[MAX_ITENS_COMPARACAO];
+    int num_estrategias = 0, num_tamanhos = 0;
 
-        if (!sucesso) {
-            printf("Erro: Falha na alocação PID %d (%s fit)\n", pid, algoritmo);
+    if (lista_estrategias) {
+        for (char *nome = strtok(lista_estrategias, ","); nome && num_estrategias < MAX_ITENS_COMPARACAO;
+             nome = strtok(NULL, ",")) {
+            if (!estrategia_por_nome(nome)) {
+                fprintf(stderr, "Erro: estratégia desconhecida: %s\n", nome);
+                return 1;
+            }
+            estrategias[num_estrategias++] = nome;
+        }
+    } else {
+        while (nomes_estrategias[num_estrategias]) {
+            estrategias[num_estrategias] = nomes_estrategias[num_estrategias];
+            num_estrategias++;
         }
+    }
 
-    } else if (strcmp(comando, "liberar") == 0) {
-        fscanf(f, "%d", &pid);
-        liberar_memoria(pid);
+    num_tamanhos = ler_tamanhos(lista_tamanhos, tamanho_padrao, tamanhos);
+    if (num_tamanhos < 0) return 1;
+
+    trace_t trace;
+    if (trace_carregar(arquivo_trace, &trace) < 0) {
+        perror("Erro ao abrir trace");
+        return 1;
     }
+    if (trace.invalidas > 0)
+        fprintf(stderr, "Aviso: %ld linhas inválidas do trace não serão reproduzidas\n", trace.invalidas);
 
-    fclose(f);
+    int total = num_estrategias * num_tamanhos;
+    resultado_comparacao_t *resultados = malloc(total * sizeof(resultado_comparacao_t));
+    comparar_estrategias(&trace, estrategias, num_estrategias, tamanhos, num_tamanhos, resultados);
+    imprimir_comparacao(resultados, total, stdout);
+
+    free(resultados);
+    trace_liberar(&trace);
+    return 0;
+}
+
+/**
+ * @brief Executa o modo de paginação e imprime uma linha por política e tamanho.
+ *
+ * @param arquivo_trace Trace de referências (`-` para stdin, ver `trace_paginacao_carregar`).
+ * @param lista_politicas Políticas separadas por vírgula, ou NULL para todas.
+ * @param lista_tamanhos Tamanhos separados por vírgula, ou NULL para `tamanho_padrao`.
+ * @param tamanho_padrao Tamanho da memória quando nenhum é informado.
+ * @param tamanho_pagina Unidades por página.
+ * @param entradas_tlb Entradas da TLB.
+ * @return int Código de saída do programa.
+ */
+static int executar_paginacao(const char *arquivo_trace, char *lista_politicas, char *lista_tamanhos,
+                              bloco_t tamanho_padrao, bloco_t tamanho_pagina, int entradas_tlb) {
+    int politicas[NUM_SUBSTITUICOES];
+    bloco_t tamanhos[MAX_ITENS_COMPARACAO];
+    int num_politicas = 0, num_tamanhos;
+
+    if (lista_politicas) {
+        for (char *nome = strtok(lista_politicas, ","); nome && num_politicas < NUM_SUBSTITUICOES;
+             nome = strtok(NULL, ",")) {
+            politicas[num_politicas] = substituicao_por_nome(nome);
+            if (politicas[num_politicas] < 0) {
+                fprintf(stderr, "Erro: política de substituição desconhecida: %s\n", nome);
+                return 1;
+            }
+            num_politicas++;
+        }
+    } else {
+        for (; num_politicas < NUM_SUBSTITUICOES; num_politicas++) politicas[num_politicas] = num_politicas;
+    }
+
+    num_tamanhos = ler_tamanhos(lista_tamanhos, tamanho_padrao, tamanhos);
+    if (num_tamanhos < 0) return 1;
+
+    trace_paginacao_t trace;
+    if (trace_paginacao_carregar(arquivo_trace, &trace) < 0) {
+        perror("Erro ao abrir trace");
+        return 1;
+    }
+
+    printf("%-6s %10s %8s %10s %10s %8s %8s %10s %9s\n", "polit", "memoria", "quadros", "acessos",
+           "faltas", "% falta", "% TLB", "substit", "ms");
+
+    for (int k = 0; k < num_politicas; k++)
+        for (int t = 0; t < num_tamanhos; t++) {
+            paginacao_t p;
+            if (paginacao_criar(&p, tamanhos[t], tamanho_pagina, entradas_tlb, politicas[k]) < 0) {
+                fprintf(stderr, "Erro: memória de %lld unidades não comporta uma página de %lld\n",
+                        tamanhos[t], tamanho_pagina);
+                trace_paginacao_liberar(&trace);
+                return 1;
+            }
+
+            struct timespec inicio, fim;
+            clock_gettime(CLOCK_MONOTONIC, &inicio);
+            paginacao_reproduzir(&p, &trace);
+            clock_gettime(CLOCK_MONOTONIC, &fim);
+            double ms = (fim.tv_sec - inicio.tv_sec) * 1e3 + (fim.tv_nsec - inicio.tv_nsec) / 1e6;
+
+            const contadores_paginacao_t *c = &p.contadores;
+            printf("%-6s %10lld %8d %10ld %10ld %7.2f%% %7.2f%% %10ld %9.1f\n",
+                   nomes_substituicao[politicas[k]], tamanhos[t], p.num_quadros, c->acessos, c->faltas,
+                   c->acessos ? 100.0 * c->faltas / c->acessos : 0.0,
+                   c->acessos ? 100.0 * c->acertos_tlb / c->acessos : 0.0, c->substituicoes, ms);
+            paginacao_destruir(&p);
+        }
+
+    trace_paginacao_liberar(&trace);
+    return 0;
+}
+
+/**
+ * @brief Carrega o estado inicial da memória.
+ *
+ * Com diário, a memória é recuperada do diário quando ele existe (ele é
+ * sempre mais recente que o arquivo de estado); caso contrário, é lida do
+ * arquivo de estado e um novo diário é iniciado a partir dela.
+ *
+ * @param sim Simulação a preencher.
+ * @param arquivo_estado Arquivo de estado (texto ou binário).
+ * @param arquivo_diario Arquivo do diário, ou NULL para não usar diário.
+ */
+static void carregar_inicial(simulador_t *sim, const char *arquivo_estado, const char *arquivo_diario) {
+    int recuperado = arquivo_diario && diario_recuperar(sim, arquivo_diario) == 0;
+    if (!recuperado)
+        carregar_memoria(sim, arquivo_estado);
+    if (arquivo_diario)
+        diario_abrir(sim, arquivo_diario, recuperado);
+}
+
+/// Se diferente de zero, as métricas são escritas na saída de erro ao encerrar
+static int exibir_metricas = 0;
+
+/**
+ * @brief Grava o estado final e compacta o diário, se houver.
+ */
+static void finalizar(simulador_t *sim) {
+    if (exibir_metricas) {
+        metricas_json(&sim->metricas, stderr);
+        fputc('\n', stderr);
+    }
+    log_encerrar();
+    salvar_estado(sim, NULL);
+    if (diario_ativo(sim)) {
+        diario_checkpoint(sim);
+        diario_fechar(sim);
+    }
+    simulador_destruir(sim);
 }
 
 /**
@@ -79,18 +300,207 @@ void processar_comando(const char *arquivo_comando) {
  * passados como argumentos na linha de comando. Se não forem informados,
  * valores padrão serão usados.
  *
+ * Opções:
+ * - `--tamanho <unidades>` — tamanho da memória simulada (padrão: `TAM_MEMORIA`).
+ *   Estados salvos no formato de extensões trazem o próprio tamanho.
+ * - `--lote <arquivo>` — executa todos os comandos do arquivo (`-` para stdin)
+ *   em uma única execução, gravando o estado apenas no final.
+ * - `--checkpoint <n>` — grava o estado também a cada `n` comandos (com diário,
+ *   a cada `n` operações registradas, compactando o diário).
+ * - `--diario <arquivo>` — registra cada operação no diário (ver `diario.h`).
+ *   No modo de comando único, o estado deixa de ser regravado a cada execução:
+ *   só o diário cresce, até o próximo checkpoint.
+ * - `--binario` — grava o estado no formato binário mapeável (`estado_binario.h`).
+ *   Na leitura, o formato é sempre detectado automaticamente.
+ * - `--pipe` — modo servidor pela entrada/saída padrão: cada linha recebida é
+ *   respondida imediatamente, até `sair` ou o fim da entrada.
+ * - `--servidor <socket>` — modo servidor por socket Unix (ver `servidor.h`).
+ * - `--espera <fifo|menor>` — alocações sem espaço esperam na fila (ver `espera.h`)
+ *   em vez de falhar, e são refeitas quando uma liberação ou compactação abre espaço.
+ * - `--prazo-espera <n>` — descarta pedidos que esperam mais de `n` comandos
+ *   (padrão: 0, sem prazo; o `alocar` pode trazer o próprio prazo).
+ * - `--alteracoes` — cada `ok` traz os trechos alterados pelo comando, e os
+ *   comandos com resposta própria que mudam a memória mandam esse `ok` numa
+ *   segunda linha (ver `definir_alteracoes`); usada pela interface gráfica.
+ * - `--comparar <trace>` — reproduz o trace para cada estratégia e tamanho de
+ *   memória, em paralelo, e imprime uma tabela comparativa (ver `comparacao.h`).
+ *   Nenhum estado é lido ou gravado.
+ * - `--estrategias <e1,e2,...>` — estratégias comparadas (padrão: todas).
+ * - `--tamanhos <t1,t2,...>` — tamanhos de memória comparados (padrão: `--tamanho`).
+ * - `--paginacao <trace>` — reproduz um trace de referências `<pid> <endereço>`
+ *   no modelo paginado (ver `paginacao.h`), uma vez por política e tamanho de
+ *   memória (`--tamanhos`), e imprime faltas de página e acertos da TLB.
+ * - `--substituicao <p1,p2,...>` — políticas de substituição: `fifo`, `lru`,
+ *   `clock` (padrão: todas).
+ * - `--pagina <unidades>` — tamanho da página (padrão: `TAM_PAGINA_PADRAO`).
+ * - `--tlb <entradas>` — entradas da TLB (padrão: `ENTRADAS_TLB_PADRAO`; 0 = sem TLB).
+ * - `--log <arquivo>` — registra as falhas de alocação e as liberações de PIDs
+ *   inexistentes no arquivo (ver `log.h`). Sem esta opção, nada é registrado.
+ * - `--nivel-log <nivel>` — nível mínimo registrado: `depuracao`, `info`,
+ *   `aviso` (padrão) ou `erro`.
+ * - `--metricas` — nos modos lote e servidor, escreve as métricas do alocador
+ *   (ver `metricas.h`) em JSON na saída de erro ao encerrar.
+ *
+ * Nos modos lote e servidor, o único argumento posicional é o arquivo de
+ * estado, gravado ao encerrar.
+ *
  * @param argc Número de argumentos.
  * @param argv Vetor de argumentos.
  * @return int Retorna 0 em caso de execução bem-sucedida.
  */
 int main(int argc, char *argv[]) {
-    const char *arquivo_comando = (argc > 1) ? argv[1] : "comando.txt";
-    const char *arquivo_estado  = (argc > 2) ? argv[2] : "estado.txt";
+    const char *arquivo_comando = "comando.txt";
+    const char *arquivo_estado  = "estado.txt";
+    bloco_t tamanho_memoria = TAM_MEMORIA;
+    const char *arquivo_lote = NULL;
+    const char *arquivo_diario = NULL;
+    const char *caminho_socket = NULL;
+    const char *arquivo_trace = NULL;
+    const char *arquivo_paginacao = NULL;
+    char *lista_politicas = NULL;
+    bloco_t tamanho_pagina = TAM_PAGINA_PADRAO;
+    int entradas_tlb = ENTRADAS_TLB_PADRAO;
+    char *lista_estrategias = NULL, *lista_tamanhos = NULL;
+    const char *arquivo_log = NULL;
+    int nivel_log = NIVEL_LOG_AVISO;
+    int modo_pipe = 0;
+    int politica_espera = ESPERA_DESLIGADA;
+    unsigned long long prazo_espera = 0;
+    int binario = 0;
+    long checkpoint = 0;
+    int alteracoes = 0;
+    const char *posicionais[2] = { NULL, NULL };
+    int num_posicionais = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tamanho") == 0 && i + 1 < argc) {
+            tamanho_memoria = strtoll(argv[++i], NULL, 10);
+            if (tamanho_memoria <= 0) {
+                fprintf(stderr, "Erro: tamanho de memória inválido: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--lote") == 0 && i + 1 < argc) {
+            arquivo_lote = argv[++i];
+        } else if (strcmp(argv[i], "--diario") == 0 && i + 1 < argc) {
+            arquivo_diario = argv[++i];
+        } else if (strcmp(argv[i], "--binario") == 0) {
+            binario = 1;
+        } else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc) {
+            arquivo_log = argv[++i];
+        } else if (strcmp(argv[i], "--nivel-log") == 0 && i + 1 < argc) {
+            nivel_log = log_nivel_por_nome(argv[++i]);
+            if (nivel_log < 0) {
+                fprintf(stderr, "Erro: nível de log inválido: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--metricas") == 0) {
+            exibir_metricas = 1;
+        } else if (strcmp(argv[i], "--espera") == 0 && i + 1 < argc) {
+            politica_espera = espera_politica_por_nome(argv[++i]);
+            if (politica_espera < 0) {
+                fprintf(stderr, "Erro: política de espera inválida: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--prazo-espera") == 0 && i + 1 < argc) {
+            prazo_espera = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--alteracoes") == 0) {
+            alteracoes = 1;
+        } else if (strcmp(argv[i], "--pipe") == 0) {
+            modo_pipe = 1;
+        } else if (strcmp(argv[i], "--servidor") == 0 && i + 1 < argc) {
+            caminho_socket = argv[++i];
+        } else if (strcmp(argv[i], "--comparar") == 0 && i + 1 < argc) {
+            arquivo_trace = argv[++i];
+        } else if (strcmp(argv[i], "--estrategias") == 0 && i + 1 < argc) {
+            lista_estrategias = argv[++i];
+        } else if (strcmp(argv[i], "--tamanhos") == 0 && i + 1 < argc) {
+            lista_tamanhos = argv[++i];
+        } else if (strcmp(argv[i], "--paginacao") == 0 && i + 1 < argc) {
+            arquivo_paginacao = argv[++i];
+        } else if (strcmp(argv[i], "--substituicao") == 0 && i + 1 < argc) {
+            lista_politicas = argv[++i];
+        } else if (strcmp(argv[i], "--pagina") == 0 && i + 1 < argc) {
+            tamanho_pagina = strtoll(argv[++i], NULL, 10);
+            if (tamanho_pagina <= 0) {
+                fprintf(stderr, "Erro: tamanho de página inválido: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--tlb") == 0 && i + 1 < argc) {
+            entradas_tlb = strtol(argv[++i], NULL, 10);
+            if (entradas_tlb < 0) {
+                fprintf(stderr, "Erro: número de entradas da TLB inválido: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            checkpoint = strtol(argv[++i], NULL, 10);
+        } else if (num_posicionais < 2) {
+            posicionais[num_posicionais++] = argv[i];
+        }
+    }
+
+    // O eco no terminal misturaria o log às respostas dos comandos
+    log_configurar(arquivo_log, nivel_log, 0);
+
+    if (arquivo_trace)
+        return executar_comparacao(arquivo_trace, lista_estrategias, lista_tamanhos, tamanho_memoria);
+    if (arquivo_paginacao)
+        return executar_paginacao(arquivo_paginacao, lista_politicas, lista_tamanhos, tamanho_memoria,
+                                  tamanho_pagina, entradas_tlb);
 
-    carregar_memoria(arquivo_estado);
-    processar_comando(arquivo_comando);
-    salvar_memoria(arquivo_estado);
+    simulador_t simulador;
+    simulador_criar(&simulador, tamanho_memoria);
+    espera_configurar(&simulador, politica_espera, prazo_espera);
+    definir_checkpoint(&simulador, checkpoint);
+    definir_alteracoes(&simulador, alteracoes);
+
+    if (caminho_socket || modo_pipe) {
+        if (posicionais[0]) arquivo_estado = posicionais[0];
+        definir_arquivo_estado(&simulador, arquivo_estado, binario);
+        carregar_inicial(&simulador, arquivo_estado, arquivo_diario);
+
+        int status = 0;
+        if (caminho_socket)
+            status = servir_socket(&simulador, caminho_socket) < 0 ? 1 : 0;
+        else {
+            instalar_sinais_encerramento();
+            processar_lote(&simulador, stdin, stdout, 1);
+        }
+
+        finalizar(&simulador);
+        return status;
+    }
+
+    if (arquivo_lote) {
+        if (posicionais[0]) arquivo_estado = posicionais[0];
+        definir_arquivo_estado(&simulador, arquivo_estado, binario);
+
+        FILE *entrada = strcmp(arquivo_lote, "-") == 0 ? stdin : fopen(arquivo_lote, "r");
+        if (!entrada) {
+            perror("Erro ao abrir arquivo de lote");
+            return 1;
+        }
+
+        carregar_inicial(&simulador, arquivo_estado, arquivo_diario);
+        processar_lote(&simulador, entrada, stdout, 0);
+        finalizar(&simulador);
+
+        if (entrada != stdin) fclose(entrada);
+        return 0;
+    }
+
+    if (posicionais[0]) arquivo_comando = posicionais[0];
+    if (posicionais[1]) arquivo_estado = posicionais[1];
+    definir_arquivo_estado(&simulador, arquivo_estado, binario);
+
+    carregar_inicial(&simulador, arquivo_estado, arquivo_diario);
+    processar_comando(&simulador, arquivo_comando);
+
+    // Com diário, a operação já está registrada; o estado só é regravado nos checkpoints
+    if (diario_ativo(&simulador))
+        diario_fechar(&simulador);
+    else
+        salvar_estado(&simulador, arquivo_estado);
+    simulador_destruir(&simulador);
 
     return 0;
 }
-
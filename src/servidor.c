@@ -0,0 +1,168 @@
+/**
+ * @file servidor.c
+ * @brief Implementação do servidor de comandos sobre socket Unix.
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../include/servidor.h"
+#include "../include/comandos.h"
+
+/// Conexão de um cliente e os bytes recebidos que ainda não formam uma linha.
+typedef struct {
+    int fd;                     ///< Descritor do socket do cliente
+    FILE *saida;                ///< Fluxo de escrita das respostas
+    char pendente[TAM_LINHA];   ///< Linha parcialmente recebida
+    size_t tam_pendente;        ///< Bytes em `pendente`
+} cliente_t;
+
+/// Sinalizado por SIGINT/SIGTERM para encerrar o laço principal
+static volatile sig_atomic_t encerrar = 0;
+
+static void tratar_sinal(int sinal) {
+    (void)sinal;
+    encerrar = 1;
+}
+
+void instalar_sinais_encerramento() {
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = tratar_sinal; // sem SA_RESTART: leituras bloqueadas são interrompidas
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+}
+
+int encerramento_pedido() {
+    return encerrar;
+}
+
+static void fechar_cliente(cliente_t *c) {
+    fclose(c->saida); // também fecha c->fd
+    c->fd = -1;
+}
+
+/**
+ * @brief Processa os bytes recebidos de um cliente, linha a linha.
+ * @return resultado_comando_t COMANDO_SAIR ou COMANDO_DESLIGAR se a conexão
+ *         ou o servidor devem ser encerrados; COMANDO_OK caso contrário.
+ */
+static resultado_comando_t receber(simulador_t *sim, cliente_t *c, const char *dados, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (dados[i] != '\n') {
+            // Linhas longas demais são truncadas
+            if (c->tam_pendente < TAM_LINHA - 1)
+                c->pendente[c->tam_pendente++] = dados[i];
+            continue;
+        }
+
+        c->pendente[c->tam_pendente] = '\0';
+        c->tam_pendente = 0;
+
+        resultado_comando_t r = responder_comando(sim, c->pendente, c->saida);
+        if (r == COMANDO_SAIR || r == COMANDO_DESLIGAR) {
+            fflush(c->saida);
+            return r;
+        }
+    }
+
+    fflush(c->saida);
+    return COMANDO_OK;
+}
+
+int servir_socket(simulador_t *sim, const char *caminho) {
+    struct sockaddr_un endereco;
+    memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    if (strlen(caminho) >= sizeof(endereco.sun_path)) {
+        fprintf(stderr, "Erro: caminho de socket longo demais: %s\n", caminho);
+        return -1;
+    }
+    strcpy(endereco.sun_path, caminho);
+
+    // Só um socket antigo pode ser removido: um erro no caminho não apaga arquivos
+    struct stat st;
+    if (lstat(caminho, &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            fprintf(stderr, "Erro: %s já existe e não é um socket\n", caminho);
+            return -1;
+        }
+        unlink(caminho);
+    }
+
+    int escuta = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (escuta < 0) {
+        perror("Erro ao criar socket");
+        return -1;
+    }
+
+    if (bind(escuta, (struct sockaddr *)&endereco, sizeof(endereco)) < 0 || listen(escuta, 16) < 0) {
+        perror("Erro ao abrir socket");
+        close(escuta);
+        return -1;
+    }
+
+    instalar_sinais_encerramento();
+    signal(SIGPIPE, SIG_IGN);
+
+    cliente_t clientes[MAX_CLIENTES];
+    int num_clientes = 0;
+    struct pollfd fds[MAX_CLIENTES + 1];
+    char dados[4096];
+    int desligar = 0;
+
+    while (!encerrar && !desligar) {
+        fds[0].fd = escuta;
+        fds[0].events = POLLIN;
+        for (int i = 0; i < num_clientes; i++) {
+            fds[i + 1].fd = clientes[i].fd;
+            fds[i + 1].events = POLLIN;
+        }
+
+        if (poll(fds, num_clientes + 1, -1) < 0) {
+            if (errno == EINTR) continue;
+            perror("Erro em poll");
+            break;
+        }
+
+        for (int i = 0; i < num_clientes && !desligar; i++) {
+            if (!fds[i + 1].revents) continue;
+
+            ssize_t n = read(clientes[i].fd, dados, sizeof(dados));
+            resultado_comando_t r = n > 0 ? receber(sim, &clientes[i], dados, n) : COMANDO_SAIR;
+            if (r == COMANDO_DESLIGAR) desligar = 1;
+            if (r == COMANDO_SAIR || r == COMANDO_DESLIGAR) fechar_cliente(&clientes[i]);
+        }
+
+        // Remove as conexões encerradas
+        int k = 0;
+        for (int i = 0; i < num_clientes; i++)
+            if (clientes[i].fd >= 0) clientes[k++] = clientes[i];
+        num_clientes = k;
+
+        if ((fds[0].revents & POLLIN) && !desligar) {
+            int fd = accept(escuta, NULL, NULL);
+            FILE *saida = fd >= 0 && num_clientes < MAX_CLIENTES ? fdopen(fd, "w") : NULL;
+            if (saida) {
+                cliente_t *c = &clientes[num_clientes++];
+                c->fd = fd;
+                c->saida = saida;
+                c->tam_pendente = 0;
+            } else if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    for (int i = 0; i < num_clientes; i++)
+        fechar_cliente(&clientes[i]);
+    close(escuta);
+    unlink(caminho);
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file tabela_pid.c
+ * @brief Implementação da tabela hash de processos e suas extensões.
+ */
+
+#include <stdlib.h>
+#include "../include/tabela_pid.h"
+
+/// Número inicial de baldes da tabela
+#define BALDES_INICIAIS 64
+
+static unsigned balde_de(int pid, int num_baldes) {
+    unsigned h = (unsigned)pid * 2654435761u; // hash multiplicativo de Knuth
+    return h & (unsigned)(num_baldes - 1);
+}
+
+/// Dobra o número de baldes quando a tabela fica cheia demais.
+static void crescer(tabela_pid_t *tabela) {
+    int novo_num = tabela->num_baldes ? tabela->num_baldes * 2 : BALDES_INICIAIS;
+    entrada_pid_t **novos = calloc(novo_num, sizeof(entrada_pid_t *));
+
+    for (int b = 0; b < tabela->num_baldes; b++) {
+        entrada_pid_t *e = tabela->baldes[b];
+        while (e) {
+            entrada_pid_t *prox = e->prox;
+            unsigned destino = balde_de(e->pid, novo_num);
+            e->prox = novos[destino];
+            novos[destino] = e;
+            e = prox;
+        }
+    }
+
+    free(tabela->baldes);
+    tabela->baldes = novos;
+    tabela->num_baldes = novo_num;
+}
+
+void tabela_limpar(tabela_pid_t *tabela) {
+    for (int b = 0; b < tabela->num_baldes; b++) {
+        entrada_pid_t *e = tabela->baldes[b];
+        while (e) {
+            entrada_pid_t *prox = e->prox;
+            free(e->extensoes);
+            free(e);
+            e = prox;
+        }
+        tabela->baldes[b] = NULL;
+    }
+    tabela->quantidade = 0;
+}
+
+entrada_pid_t *tabela_buscar(const tabela_pid_t *tabela, int pid) {
+    if (tabela->num_baldes == 0) return NULL;
+
+    entrada_pid_t *e = tabela->baldes[balde_de(pid, tabela->num_baldes)];
+    while (e && e->pid != pid)
+        e = e->prox;
+    return e;
+}
+
+void tabela_adicionar(tabela_pid_t *tabela, int pid, bloco_t inicio, bloco_t tamanho) {
+    entrada_pid_t *e = tabela_buscar(tabela, pid);
+
+    if (!e) {
+        if (tabela->quantidade >= tabela->num_baldes)
+            crescer(tabela);
+
+        e = calloc(1, sizeof(entrada_pid_t));
+        e->pid = pid;
+        unsigned b = balde_de(pid, tabela->num_baldes);
+        e->prox = tabela->baldes[b];
+        tabela->baldes[b] = e;
+        tabela->quantidade++;
+    }
+
+    if (e->quantidade == e->capacidade) {
+        e->capacidade = e->capacidade ? e->capacidade * 2 : 1;
+        e->extensoes = realloc(e->extensoes, e->capacidade * sizeof(extensao_t));
+    }
+    e->extensoes[e->quantidade].inicio = inicio;
+    e->extensoes[e->quantidade].tamanho = tamanho;
+    e->quantidade++;
+}
+
+void tabela_remover(tabela_pid_t *tabela, int pid) {
+    if (tabela->num_baldes == 0) return;
+
+    entrada_pid_t **p = &tabela->baldes[balde_de(pid, tabela->num_baldes)];
+    while (*p && (*p)->pid != pid)
+        p = &(*p)->prox;
+    if (!*p) return;
+
+    entrada_pid_t *e = *p;
+    *p = e->prox;
+    free(e->extensoes);
+    free(e);
+    tabela->quantidade--;
+}
+
+extensao_t *tabela_buscar_extensao(const tabela_pid_t *tabela, int pid, bloco_t inicio) {
+    entrada_pid_t *e = tabela_buscar(tabela, pid);
+    if (!e) return NULL;
+
+    for (int k = 0; k < e->quantidade; k++)
+        if (e->extensoes[k].inicio == inicio)
+            return &e->extensoes[k];
+    return NULL;
+}
+
+void tabela_remover_extensao(tabela_pid_t *tabela, int pid, bloco_t inicio) {
+    entrada_pid_t *e = tabela_buscar(tabela, pid);
+    extensao_t *ext = tabela_buscar_extensao(tabela, pid, inicio);
+    if (!ext) return;
+
+    // A última extensão ocupa o lugar da removida
+    *ext = e->extensoes[--e->quantidade];
+    if (e->quantidade == 0)
+        tabela_remover(tabela, pid);
+}
@@ -0,0 +1,160 @@
+/**
+ * @file varredura.c
+ * @brief Implementações escalar, SSE2 e AVX2 dos kernels de varredura.
+ *
+ * As versões vetoriais comparam um bloco de elementos com `valor`, extraem
+ * uma máscara de bits (um bit por elemento) e usam a contagem de zeros à
+ * direita para achar o primeiro elemento diferente/igual. A sobra que não
+ * completa um bloco é tratada pela versão escalar.
+ */
+
+#include <string.h>
+#include <pthread.h>
+#include "../include/varredura.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define VARREDURA_X86 1
+#endif
+
+/* ---------------- Escalar ---------------- */
+
+static size_t comprimento_escalar(const int *v, size_t n, int valor) {
+    size_t i = 0;
+    while (i < n && v[i] == valor) i++;
+    return i;
+}
+
+static size_t procurar_escalar(const int *v, size_t n, int valor) {
+    size_t i = 0;
+    while (i < n && v[i] != valor) i++;
+    return i;
+}
+
+#ifdef VARREDURA_X86
+
+/* ---------------- SSE2 (4 elementos por comparação) ---------------- */
+
+__attribute__((target("sse2")))
+static size_t comprimento_sse2(const int *v, size_t n, int valor) {
+    const __m128i alvo = _mm_set1_epi32(valor);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(v + i));
+        unsigned iguais = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, alvo)));
+        if (iguais != 0xF) return i + __builtin_ctz(~iguais);
+    }
+    return i + comprimento_escalar(v + i, n - i, valor);
+}
+
+__attribute__((target("sse2")))
+static size_t procurar_sse2(const int *v, size_t n, int valor) {
+    const __m128i alvo = _mm_set1_epi32(valor);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(v + i));
+        unsigned iguais = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(x, alvo)));
+        if (iguais) return i + __builtin_ctz(iguais);
+    }
+    return i + procurar_escalar(v + i, n - i, valor);
+}
+
+/* ---------------- AVX2 (8 elementos por comparação) ---------------- */
+
+__attribute__((target("avx2")))
+static size_t comprimento_avx2(const int *v, size_t n, int valor) {
+    const __m256i alvo = _mm256_set1_epi32(valor);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(v + i));
+        unsigned iguais = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, alvo)));
+        if (iguais != 0xFF) return i + __builtin_ctz(~iguais);
+    }
+    return i + comprimento_escalar(v + i, n - i, valor);
+}
+
+__attribute__((target("avx2")))
+static size_t procurar_avx2(const int *v, size_t n, int valor) {
+    const __m256i alvo = _mm256_set1_epi32(valor);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(v + i));
+        unsigned iguais = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(x, alvo)));
+        if (iguais) return i + __builtin_ctz(iguais);
+    }
+    return i + procurar_escalar(v + i, n - i, valor);
+}
+
+#endif // VARREDURA_X86
+
+/* ---------------- Seleção em tempo de execução ---------------- */
+
+/// Uma implementação dos kernels.
+typedef struct {
+    const char *nome;
+    size_t (*comprimento)(const int *, size_t, int);
+    size_t (*procurar)(const int *, size_t, int);
+} implementacao_t;
+
+static const implementacao_t escalar = { "escalar", comprimento_escalar, procurar_escalar };
+#ifdef VARREDURA_X86
+static const implementacao_t sse2 = { "sse2", comprimento_sse2, procurar_sse2 };
+static const implementacao_t avx2 = { "avx2", comprimento_avx2, procurar_avx2 };
+#endif
+
+/// Implementação em uso (escolhida na primeira chamada, uma única vez entre as threads)
+static const implementacao_t *atual = NULL;
+static pthread_once_t escolha = PTHREAD_ONCE_INIT;
+
+static int suportada(const implementacao_t *impl) {
+#ifdef VARREDURA_X86
+    __builtin_cpu_init();
+    if (impl == &avx2) return __builtin_cpu_supports("avx2");
+    if (impl == &sse2) return __builtin_cpu_supports("sse2");
+#endif
+    return impl == &escalar;
+}
+
+static void escolher() {
+    atual = &escalar;
+#ifdef VARREDURA_X86
+    if (suportada(&sse2)) atual = &sse2;
+    if (suportada(&avx2)) atual = &avx2;
+#endif
+}
+
+static const implementacao_t *implementacao() {
+    pthread_once(&escolha, escolher);
+    return atual;
+}
+
+size_t varredura_comprimento(const int *v, size_t n, int valor) {
+    return implementacao()->comprimento(v, n, valor);
+}
+
+size_t varredura_procurar(const int *v, size_t n, int valor) {
+    return implementacao()->procurar(v, n, valor);
+}
+
+const char *varredura_implementacao() {
+    return implementacao()->nome;
+}
+
+int varredura_selecionar(const char *nome) {
+    const implementacao_t *opcoes[] = {
+#ifdef VARREDURA_X86
+        &avx2, &sse2,
+#endif
+        &escalar
+    };
+
+    // A escolha automática não pode sobrescrever depois a implementação forçada
+    pthread_once(&escolha, escolher);
+    for (size_t k = 0; k < sizeof(opcoes) / sizeof(opcoes[0]); k++) {
+        if (strcmp(opcoes[k]->nome, nome) == 0 && suportada(opcoes[k])) {
+            atual = opcoes[k];
+            return 0;
+        }
+    }
+    return -1;
+}
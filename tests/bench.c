@@ -0,0 +1,146 @@
+/**
+ * @file bench.c
+ * @brief Benchmark das estratégias de alocação com cargas sintéticas.
+ *
+ * Para cada estratégia, cada distribuição de tamanhos (uniforme, bimodal e
+ * de cauda pesada) e cada disciplina de tempo de vida (LIFO, FIFO e
+ * aleatória), executa uma sequência de alocações e liberações que mantém
+ * cerca de `VIVOS` processos na memória e mede:
+ * - vazão (operações por segundo);
+ * - latência por operação (p50 e p99, em ns);
+ * - taxa de falha das alocações;
+ * - pico do índice de fragmentação (1 - maior região / livres).
+ *
+ * Uso: make bench
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "../include/memoria.h"
+#include "../include/alocacao.h"
+
+#define TAMANHO_MEMORIA (1 << 18)
+#define OPERACOES 100000
+#define VIVOS 3000
+
+/// Estratégia de alocação avaliada.
+typedef struct {
+    const char *nome;
+    funcao_alocacao_t alocar;
+} estrategia_t;
+
+static const estrategia_t estrategias[] = {
+    { "first", first_fit }, { "best", best_fit }, { "worst", worst_fit },
+    { "next", next_fit },   { "seg", segregado_fit }, { "buddy", buddy_fit },
+};
+
+enum { UNIFORME, BIMODAL, CAUDA_PESADA, NUM_DISTRIBUICOES };
+static const char *nomes_distribuicao[] = { "uniforme", "bimodal", "cauda" };
+
+enum { LIFO, FIFO, ALEATORIO, NUM_VIDAS };
+static const char *nomes_vida[] = { "lifo", "fifo", "aleat" };
+
+/// Sorteia um tamanho de pedido segundo a distribuição.
+static bloco_t sortear_tamanho(int distribuicao, unsigned *semente) {
+    switch (distribuicao) {
+    case UNIFORME:
+        return 1 + rand_r(semente) % 256;
+    case BIMODAL:
+        // 90% de pedidos pequenos, 10% grandes
+        if (rand_r(semente) % 10) return 1 + rand_r(semente) % 16;
+        return 512 + rand_r(semente) % 1537;
+    default: {
+        // Pareto com alfa = 1,2, limitado a 2^16 blocos
+        double u = (rand_r(semente) + 1.0) / ((double)RAND_MAX + 2.0);
+        double t = pow(u, -1.0 / 1.2);
+        return t > 65536 ? 65536 : (bloco_t)t;
+    }
+    }
+}
+
+static long long agora_ns() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+static int comparar_latencias(const void *a, const void *b) {
+    unsigned x = *(const unsigned *)a, y = *(const unsigned *)b;
+    return (x > y) - (x < y);
+}
+
+/// Executa uma combinação e imprime uma linha da tabela.
+static void executar(const estrategia_t *estrategia, int distribuicao, int vida) {
+    static unsigned latencias[OPERACOES];
+    int vivos[VIVOS]; // fila circular dos PIDs vivos, do mais antigo ao mais novo
+    int frente = 0, quantidade = 0, proximo_pid = 1;
+    long pedidos = 0, falhas = 0;
+    double pico_fragmentacao = 0;
+    unsigned semente = 2024;
+
+    simulador_t sim;
+    simulador_criar(&sim, TAMANHO_MEMORIA);
+    long long inicio = agora_ns();
+
+    for (int op = 0; op < OPERACOES; op++) {
+        // Alocações um pouco mais frequentes mantêm a memória perto de `VIVOS` processos
+        int alocar = quantidade == 0 || (quantidade < VIVOS && rand_r(&semente) % 5 < 3);
+        long long t0;
+
+        if (alocar) {
+            bloco_t tamanho = sortear_tamanho(distribuicao, &semente);
+            int pid = proximo_pid++;
+            t0 = agora_ns();
+            int sucesso = estrategia->alocar(&sim, pid, tamanho);
+            latencias[op] = (unsigned)(agora_ns() - t0);
+
+            pedidos++;
+            if (sucesso) vivos[(frente + quantidade++) % VIVOS] = pid;
+            else falhas++;
+        } else {
+            int k; // posição (a partir da frente) do processo que termina
+            if (vida == FIFO) k = 0;
+            else if (vida == LIFO) k = quantidade - 1;
+            else k = rand_r(&semente) % quantidade;
+
+            int pid = vivos[(frente + k) % VIVOS];
+            t0 = agora_ns();
+            liberar_memoria(&sim, pid);
+            latencias[op] = (unsigned)(agora_ns() - t0);
+
+            // Fecha o buraco na fila trazendo o mais novo para a posição k
+            if (k == 0) {
+                frente = (frente + 1) % VIVOS;
+            } else {
+                vivos[(frente + k) % VIVOS] = vivos[(frente + quantidade - 1) % VIVOS];
+            }
+            quantidade--;
+        }
+
+        fragmentacao_t frag;
+        calcular_fragmentacao(&sim, &frag);
+        if (frag.indice > pico_fragmentacao) pico_fragmentacao = frag.indice;
+    }
+
+    double segundos = (agora_ns() - inicio) / 1e9;
+    simulador_destruir(&sim);
+    qsort(latencias, OPERACOES, sizeof(unsigned), comparar_latencias);
+
+    printf("%-6s %-9s %-6s %12.0f %8u %8u %8.2f%% %8.3f\n", estrategia->nome,
+           nomes_distribuicao[distribuicao], nomes_vida[vida], OPERACOES / segundos,
+           latencias[OPERACOES / 2], latencias[OPERACOES * 99 / 100],
+           pedidos ? 100.0 * falhas / pedidos : 0.0, pico_fragmentacao);
+}
+
+int main() {
+    printf("%-6s %-9s %-6s %12s %8s %8s %9s %8s\n", "estrat", "tamanhos", "vida",
+           "ops/s", "p50 ns", "p99 ns", "falhas", "frag max");
+
+    for (size_t e = 0; e < sizeof(estrategias) / sizeof(estrategias[0]); e++)
+        for (int d = 0; d < NUM_DISTRIBUICOES; d++)
+            for (int v = 0; v < NUM_VIDAS; v++)
+                executar(&estrategias[e], d, v);
+    return 0;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file bench_concorrente.c
+ * @brief Benchmark de vazão da memória concorrente com 1, 2, 4 e 8 threads.
+ *
+ * Cada thread repete alocações e liberações de processos próprios, mantendo
+ * cerca de `VIVOS` processos vivos, com tamanhos de 1 a 64 blocos. Para cada
+ * número de threads, compara uma memória com um único fragmento (equivalente
+ * a uma trava global) com uma memória com um fragmento por thread.
+ *
+ * Uso: make bench-concorrente
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "../include/arena_concorrente.h"
+
+#define OPERACOES 400000
+#define VIVOS 512
+#define TAMANHO_MEMORIA (1 << 22)
+
+static arena_concorrente_t arena;
+
+static double agora() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/// Laço de trabalho de uma thread; `arg` é o número da thread.
+static void *trabalhar(void *arg) {
+    int id = (int)(long)arg;
+    unsigned semente = 12345u + id;
+    int base = id * VIVOS;
+    char vivo[VIVOS] = { 0 };
+
+    for (int op = 0; op < OPERACOES; op++) {
+        int k = rand_r(&semente) % VIVOS;
+        if (vivo[k]) {
+            arena_liberar_pid(&arena, base + k + 1);
+            vivo[k] = 0;
+        } else {
+            vivo[k] = arena_alocar_pid(&arena, base + k + 1, 1 + rand_r(&semente) % 64);
+        }
+    }
+    return NULL;
+}
+
+/// Executa o laço em `threads` threads e retorna milhões de operações por segundo.
+static double medir(int threads, int fragmentos) {
+    pthread_t ids[16];
+    arena_criar(&arena, TAMANHO_MEMORIA, fragmentos);
+
+    double inicio = agora();
+    for (long t = 0; t < threads; t++)
+        pthread_create(&ids[t], NULL, trabalhar, (void *)t);
+    for (int t = 0; t < threads; t++)
+        pthread_join(ids[t], NULL);
+    double segundos = agora() - inicio;
+
+    arena_destruir(&arena);
+    return (double)threads * OPERACOES / segundos / 1e6;
+}
+
+int main() {
+    printf("%8s %18s %22s\n", "threads", "Mops/s (1 trava)", "Mops/s (1 fragmento/thread)");
+    for (int threads = 1; threads <= 8; threads *= 2)
+        printf("%8d %18.2f %22.2f\n", threads, medir(threads, 1), medir(threads, threads));
+    return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file bench_varredura.c
+ * @brief Benchmark dos kernels de varredura (escalar x SSE2 x AVX2).
+ *
+ * Gera vetores de PIDs de 10^6 e 10^7 blocos com sequências de comprimento
+ * médio variado e mede o tempo para quebrá-los em sequências de valores
+ * iguais (o trabalho de `carregar_plano`) e para procurar o primeiro bloco
+ * de um PID ausente (varredura completa).
+ *
+ * Uso: make bench-varredura
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../include/varredura.h"
+
+/// Evita que o compilador descarte as chamadas medidas
+static volatile size_t sumidouro;
+
+static double agora() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/// Preenche `v` com sequências de comprimento aleatório com média `media`.
+static void gerar(int *v, size_t n, int media) {
+    size_t i = 0;
+    int pid = 0;
+    while (i < n) {
+        size_t comprimento = 1 + rand() % (2 * media);
+        for (size_t k = 0; k < comprimento && i < n; k++) v[i++] = pid;
+        pid = pid ? 0 : 1 + rand() % 50;
+    }
+}
+
+/// Conta as sequências de `v` usando o kernel selecionado.
+static size_t contar_sequencias(const int *v, size_t n) {
+    size_t j = 0, sequencias = 0;
+    while (j < n) {
+        j += varredura_comprimento(v + j, n - j, v[j]);
+        sequencias++;
+    }
+    return sequencias;
+}
+
+int main() {
+    const char *implementacoes[] = { "escalar", "sse2", "avx2" };
+    const size_t tamanhos[] = { 1000000, 10000000 };
+    const int medias[] = { 8, 64, 1024 };
+    const int repeticoes = 5;
+
+    printf("%-10s %10s %7s %8s %12s %12s\n", "impl", "blocos", "media", "seq", "ms/sequencias", "ms/procura");
+
+    for (size_t t = 0; t < sizeof(tamanhos) / sizeof(tamanhos[0]); t++) {
+        size_t n = tamanhos[t];
+        int *v = malloc(n * sizeof(int));
+
+        for (size_t m = 0; m < sizeof(medias) / sizeof(medias[0]); m++) {
+            srand(42);
+            gerar(v, n, medias[m]);
+
+            for (size_t k = 0; k < sizeof(implementacoes) / sizeof(implementacoes[0]); k++) {
+                if (varredura_selecionar(implementacoes[k]) < 0) continue;
+
+                size_t sequencias = 0;
+                double inicio = agora();
+                for (int r = 0; r < repeticoes; r++) sequencias = contar_sequencias(v, n);
+                double ms_sequencias = (agora() - inicio) * 1000 / repeticoes;
+
+                inicio = agora();
+                for (int r = 0; r < repeticoes; r++) sumidouro += varredura_procurar(v, n, -1);
+                double ms_procura = (agora() - inicio) * 1000 / repeticoes;
+
+                printf("%-10s %10zu %7d %8zu %12.3f %12.3f\n", implementacoes[k], n, medias[m],
+                       sequencias, ms_sequencias, ms_procura);
+            }
+        }
+        free(v);
+    }
+    return 0;
+}
@@ -3,7 +3,7 @@
  * @brief Ponto de entrada principal do simulador de Gerenciador de Memória.
  *
  * Este programa simula o funcionamento de um gerenciador de memória baseado em alocação contígua.
- * Permite testar diferentes estratégias de alocação: First Fit, Best Fit e Worst Fit.
+ * Permite testar diferentes estratégias de alocação: First Fit, Best Fit, Worst Fit e Buddy.
  * Também realiza liberação de memória, exibe o estado atual da memória, detecta fragmentação externa,
  * e salva os dados em arquivo. Registra falhas de alocação em um log.
  */
@@ -22,6 +22,9 @@
  *     - First Fit (para processos 1, 2 e 3)
  *     - Best Fit (teste com PID 1 reutilizado)
  *     - Worst Fit (para processo 6)
+ *     - Buddy (para processo 7)
+ * - Cresce o processo 3 no lugar com `realocar_memoria`.
+ * - Aloca um lote de processos (8 e 9) numa só chamada de `alocar_lote`.
  * - Libera memória previamente alocada (processo 1).
  * - Exibe o estado da memória no terminal.
  * - Salva o estado da memória em um arquivo.
@@ -31,40 +34,56 @@
  * @return int Retorna 0 ao final da execução com sucesso.
  */
 int main() {
-    // Inicializa toda a memória como livre (0)
-    inicializar_memoria();
+    // Cria a simulação com toda a memória livre
+    simulador_t sim;
+    simulador_criar(&sim, TAM_MEMORIA);
 
     // Aloca 10 blocos para o processo 1 usando First Fit
-    if (!first_fit(1, 10))
+    if (!first_fit(&sim, 1, 10))
         log_erro(1, "First Fit", "memória insuficiente");
 
     // Aloca 15 blocos para o processo 2
-    if (!first_fit(2, 15))
+    if (!first_fit(&sim, 2, 15))
         log_erro(2, "First Fit", "memória insuficiente");
 
     // Libera os blocos ocupados pelo processo 1
-    liberar_memoria(1);
+    liberar_memoria(&sim, 1);
 
     // Aloca 5 blocos para o processo 3
-    if (!first_fit(3, 5))
+    if (!first_fit(&sim, 3, 5))
         log_erro(3, "First Fit", "memória insuficiente");
 
     // Tenta alocar 10 blocos para o processo 4 usando Best Fit (PID 1 reutilizado para simular cenário)
-    if (!best_fit(1, 10))
+    if (!best_fit(&sim, 1, 10))
         log_erro(4, "Best Fit", "nenhum bloco adequado encontrado");
 
     // Tenta alocar 8 blocos para o processo 6 usando Worst Fit
-    if (!worst_fit(6, 8))
+    if (!worst_fit(&sim, 6, 8))
         log_erro(6, "Worst Fit", "nenhum bloco suficientemente grande encontrado");
 
+    // Aloca 6 blocos para o processo 7 usando Buddy (recebe um bloco alinhado de 8)
+    if (!buddy_fit(&sim, 7, 6))
+        log_erro(7, "Buddy", "nenhum bloco alinhado livre");
+
+    // Cresce o processo 3 para 8 blocos sobre a região livre seguinte, sem copiar nada
+    if (realocar_memoria(&sim, 3, 8, first_fit) < 0)
+        log_erro(3, "Realocar", "memória insuficiente");
+
+    // Aloca os processos 8 e 9 num só lote, o maior primeiro
+    pedido_lote_t lote[] = { { 8, 4, -1 }, { 9, 12, -1 } };
+    if (alocar_lote(&sim, lote, 2, first_fit, 1) < 2)
+        log_erro(0, "Lote", "nem todos os pedidos couberam");
+
     // Exibe o estado atual da memória no terminal
-    imprimir_memoria();
+    imprimir_memoria(&sim);
 
     // Salva o estado da memória em arquivo para futura análise
-    salvar_memoria("estado.txt");
+    salvar_memoria(&sim, "estado.txt");
 
     // Exibe estatísticas sobre fragmentação externa
-    exibir_fragmentacao();
+    exibir_fragmentacao(&sim);
+
+    simulador_destruir(&sim);
 
     return 0;
 }